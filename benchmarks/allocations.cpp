@@ -0,0 +1,80 @@
+// Counts heap allocations per world update for an AvidaGP world, with and without organism pooling.
+// (Allocations are counted by replacing global operator new in this benchmark.)
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include "emp/math/Random.hpp"
+
+#include "dirdevo/DirectedDevoConfig.hpp"
+#include "dirdevo/DirectedDevoWorld.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPOrganism.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPMultiPathwayTask.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPMutator.hpp"
+
+namespace {
+std::atomic<size_t> num_allocations{0};
+}
+
+void* operator new(size_t size) {
+  ++num_allocations;
+  if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+using org_t = dirdevo::AvidaGPOrganism;
+using task_t = dirdevo::AvidaGPMultiPathwayTask;
+using mutator_t = dirdevo::AvidaGPMutator;
+using world_t = dirdevo::DirectedDevoWorld<org_t,task_t>;
+
+constexpr size_t WARMUP_UPDATES = 500; // Let the population fill up before counting.
+constexpr size_t UPDATES = 1000;
+
+void RunWorld(dirdevo::DirectedDevoConfig& config, bool pooling) {
+  config.ORGANISM_POOLING(pooling);
+  emp::Random random(config.SEED());
+  world_t world(config, random, "bench_world", 0);
+  world.SetAvgOrgStepsPerUpdate(config.AVG_STEPS_PER_ORG());
+  mutator_t mutator;
+  mutator_t::Configure(mutator, config);
+  world.SetMutFun([&mutator](org_t& org, emp::Random& rnd) {
+    return dirdevo::MutateOrganism(mutator, org, rnd);
+  });
+  world.InjectAt(org_t::GenerateAncestralGenome(world, world), 0);
+  world.SyncSchedulerWeights();
+
+  for (size_t u = 0; u < WARMUP_UPDATES; ++u) {
+    world.RunStep();
+    world.Update();
+  }
+
+  const size_t start_allocations = num_allocations.load();
+  const auto start_time = std::chrono::steady_clock::now();
+  for (size_t u = 0; u < UPDATES; ++u) {
+    world.RunStep();
+    world.Update();
+  }
+  const double run_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  const size_t allocations = num_allocations.load() - start_allocations;
+
+  std::cout << (pooling ? "pooled" : "unpooled") << ":" << std::endl;
+  std::cout << "  allocations/update: " << (double)allocations / UPDATES << std::endl;
+  std::cout << "  time (s): " << run_time << std::endl;
+  std::cout << "  orgs allocated by pool: " << world.GetOrganismPool().GetNumAllocated()
+            << ", recycled: " << world.GetOrganismPool().GetNumRecycled() << std::endl;
+}
+
+int main() {
+  dirdevo::DirectedDevoConfig config;
+  config.SEED(2);
+  config.AVIDAGP_ENV_FILE("../tests/example-environment.json");
+  RunWorld(config, false);
+  RunWorld(config, true);
+  return 0;
+}
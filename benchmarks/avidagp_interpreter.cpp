@@ -0,0 +1,111 @@
+// Measures AvidaGP replicator instruction throughput (steps per second) with library dispatch (SingleProcess) versus
+// the pre-decoded interpreter (Step with an opcode table), and checks that both engines end in the same state.
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "emp/base/vector.hpp"
+#include "emp/math/Random.hpp"
+
+#include "dirdevo/DirectedDevoConfig.hpp"
+#include "dirdevo/DirectedDevoWorld.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPOrganism.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPMultiPathwayTask.hpp"
+
+using org_t = dirdevo::AvidaGPOrganism;
+using task_t = dirdevo::AvidaGPMultiPathwayTask;
+using world_t = dirdevo::DirectedDevoWorld<org_t,task_t>;
+using hardware_t = dirdevo::AvidaGPReplicator;
+
+constexpr size_t NUM_PROGRAMS = 200;
+constexpr size_t PROGRAM_SIZE = 100;
+constexpr size_t STEPS_PER_PROGRAM = 20000;
+
+/// Run every program STEPS_PER_PROGRAM steps with the given step function; returns steps per second.
+template<typename STEP_FUN>
+double Run(emp::vector<hardware_t>& programs, STEP_FUN step) {
+  const auto start_time = std::chrono::steady_clock::now();
+  for (auto& hw : programs) {
+    for (size_t i = 0; i < STEPS_PER_PROGRAM; ++i) {
+      step(hw);
+      for (size_t pathway_id = 0; pathway_id < hw.GetNumPathways(); ++pathway_id) {
+        hw.GetOutputBuffer(pathway_id).clear(); // The task clears output buffers after every step.
+      }
+    }
+  }
+  const double run_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  return (double)(programs.size() * STEPS_PER_PROGRAM) / run_time;
+}
+
+bool SameState(const hardware_t& a, const hardware_t& b) {
+  return a.GetIP() == b.GetIP()
+    && a.regs == b.regs
+    && a.GetSitesCopied() == b.GetSitesCopied()
+    && a.IsDividing() == b.IsDividing()
+    && a.GetNumFailedSelfDivisions() == b.GetNumFailedSelfDivisions();
+}
+
+void Bench(const std::string& name, const emp::vector<hardware_t>& programs, const task_t& task) {
+  emp::vector<hardware_t> library_programs(programs);
+  emp::vector<hardware_t> decoded_programs(programs);
+  for (auto& hw : decoded_programs) hw.SetOpcodeTable(&task.GetOpcodeTable());
+
+  const double library_steps_per_sec = Run(library_programs, [](hardware_t& hw) { hw.SingleProcess(); });
+  const double decoded_steps_per_sec = Run(decoded_programs, [](hardware_t& hw) { hw.Step(); });
+
+  size_t mismatches = 0;
+  for (size_t i = 0; i < programs.size(); ++i) {
+    mismatches += (size_t)!SameState(library_programs[i], decoded_programs[i]);
+  }
+
+  std::cout << name << ":" << std::endl;
+  std::cout << "  library dispatch steps/sec: " << library_steps_per_sec << std::endl;
+  std::cout << "  pre-decoded steps/sec: " << decoded_steps_per_sec << std::endl;
+  std::cout << "  speedup: " << decoded_steps_per_sec / library_steps_per_sec << std::endl;
+  std::cout << "  mismatched final states: " << mismatches << std::endl;
+}
+
+int main() {
+  dirdevo::DirectedDevoConfig config;
+  config.SEED(2);
+  config.AVIDAGP_ENV_FILE("../tests/example-environment.json");
+  emp::Random random(config.SEED());
+  world_t world(config, random, "bench_world", 0);
+  const auto& task = world.GetTask();
+  if (!task.GetOpcodeTable().IsComplete()) {
+    std::cout << "Instruction library has instructions the pre-decoded interpreter doesn't know." << std::endl;
+    return 1;
+  }
+
+  const size_t num_pathways = task.GetNumPathways();
+  const emp::vector<double> inputs({3, 5, 7, 11, 13, 17, 19, 23});
+  auto prepare = [&](hardware_t& hw) {
+    hw.ResetReplicatorHardware(num_pathways);
+    for (size_t pathway_id = 0; pathway_id < num_pathways; ++pathway_id) {
+      hw.BindEnvironment(pathway_id, 0, inputs);
+    }
+  };
+
+  // Random programs exercise the whole instruction set.
+  emp::vector<hardware_t> random_programs;
+  for (size_t i = 0; i < NUM_PROGRAMS; ++i) {
+    random_programs.emplace_back(task.GetInstLib());
+    random_programs.back().PushRandom(random, PROGRAM_SIZE);
+    prepare(random_programs.back());
+  }
+  Bench("random programs", random_programs, task);
+
+  // The ancestor is what evolving populations mostly look like early on (copy loop + divide).
+  emp::vector<hardware_t> ancestors;
+  const auto ancestor_genome = org_t::GenerateAncestralGenome(world, world);
+  for (size_t i = 0; i < NUM_PROGRAMS; ++i) {
+    ancestors.emplace_back(task.GetInstLib());
+    ancestors.back().genome = ancestor_genome;
+    prepare(ancestors.back());
+  }
+  Bench("ancestor", ancestors, task);
+
+  return 0;
+}
@@ -0,0 +1,64 @@
+// Measures offspring mutation throughput (births per second: copy the parent's genome, then mutate it) for the AvidaGP
+// and BitSet mutators with per-site sampling (one random draw per site) versus geometric-skip sampling.
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "emp/bits/BitSet.hpp"
+#include "emp/math/Random.hpp"
+
+#include "dirdevo/DirectedDevoConfig.hpp"
+#include "dirdevo/DirectedDevoWorld.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPOrganism.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPMultiPathwayTask.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPMutator.hpp"
+#include "dirdevo/mutator/BitSetMutator.hpp"
+
+constexpr size_t BIRTHS = 1000000;
+
+/// Returns births per second.
+template<typename MUTATOR_T, typename GENOME_T>
+double RunBirths(dirdevo::DirectedDevoConfig& config, const GENOME_T& parent, size_t& mutations) {
+  MUTATOR_T mutator;
+  MUTATOR_T::Configure(mutator, config);
+  emp::Random random(config.SEED());
+  mutations = 0;
+  const auto start_time = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < BIRTHS; ++i) {
+    GENOME_T offspring(parent);
+    mutations += mutator.Mutate(offspring, random);
+  }
+  const double run_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  return (double)BIRTHS / run_time;
+}
+
+template<typename MUTATOR_T, typename GENOME_T>
+void Bench(const std::string& name, dirdevo::DirectedDevoConfig& config, const GENOME_T& parent) {
+  for (const std::string sampling : {"per-site", "skip"}) {
+    config.MUTATION_SAMPLING(sampling);
+    size_t mutations = 0;
+    const double births_per_sec = RunBirths<MUTATOR_T>(config, parent, mutations);
+    std::cout << name << " (" << sampling << "):" << std::endl;
+    std::cout << "  births/sec: " << births_per_sec << std::endl;
+    std::cout << "  mutations/birth: " << (double)mutations / BIRTHS << std::endl;
+  }
+}
+
+int main() {
+  dirdevo::DirectedDevoConfig config;
+  config.SEED(2);
+  config.AVIDAGP_ENV_FILE("../tests/example-environment.json");
+
+  // AvidaGP: mutate the ancestral genome (needs a world for the instruction library).
+  using org_t = dirdevo::AvidaGPOrganism;
+  using world_t = dirdevo::DirectedDevoWorld<org_t, dirdevo::AvidaGPMultiPathwayTask>;
+  emp::Random random(config.SEED());
+  world_t world(config, random, "bench_world", 0);
+  Bench<dirdevo::AvidaGPMutator>("avidagp", config, org_t::GenerateAncestralGenome(world, world));
+
+  // BitSet (OneMax-sized genomes)
+  Bench<dirdevo::BitSetMutator>("bitset-256", config, emp::BitSet<256>());
+
+  return 0;
+}
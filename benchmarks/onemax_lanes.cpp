@@ -0,0 +1,50 @@
+// Measures OneMaxLaneWorld throughput (organism steps per second) as population size grows, to gauge how large a
+// synthetic population we can use for stress-testing population-level selection and propagule sampling.
+// Compare with the onemax steps/sec reported by world_steps (same organism logic, one organism step at a time).
+
+#include <chrono>
+#include <iostream>
+
+#include "emp/math/Random.hpp"
+
+#include "dirdevo/DirectedDevoConfig.hpp"
+#include "dirdevo/ExperimentSetups/OneMax/OneMaxLaneWorld.hpp"
+
+using lane_world_t = dirdevo::OneMaxLaneWorld<256>;
+
+constexpr size_t WARMUP_UPDATES = 200; // Let the population fill up before timing.
+constexpr size_t UPDATES = 20;
+
+void RunWorld(const dirdevo::DirectedDevoConfig& config, size_t capacity) {
+  emp::Random random(config.SEED());
+  lane_world_t world(config, random, capacity);
+  world.Inject(lane_world_t::genome_t(false));
+  for (size_t u = 0; u < WARMUP_UPDATES && world.GetNumOrgs() < capacity; ++u) {
+    world.RunStep();
+  }
+
+  size_t steps = 0;
+  const size_t start_births = world.GetTotalBirths();
+  const auto start_time = std::chrono::steady_clock::now();
+  for (size_t u = 0; u < UPDATES; ++u) {
+    steps += world.GetNumOrgs() * config.AVG_STEPS_PER_ORG();
+    world.RunStep();
+  }
+  const double run_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+  world.Evaluate();
+  std::cout << "capacity " << capacity << ":" << std::endl;
+  std::cout << "  orgs: " << world.GetNumOrgs() << std::endl;
+  std::cout << "  steps/sec: " << (double)steps / run_time << std::endl;
+  std::cout << "  births/update: " << (double)(world.GetTotalBirths() - start_births) / UPDATES << std::endl;
+  std::cout << "  average num ones: " << world.GetAverageNumOnes() << std::endl;
+}
+
+int main() {
+  dirdevo::DirectedDevoConfig config;
+  config.SEED(2);
+  for (size_t capacity : {10000, 100000, 1000000}) {
+    RunWorld(config, capacity);
+  }
+  return 0;
+}
@@ -0,0 +1,98 @@
+// Compares organism scheduler backends (emp::IndexMap vs. FenwickWeightMap): weighted-draw throughput at several slot counts.
+// Mimics DirectedDevoWorld::RunStep: mostly draws, with an occasional weight adjustment (birth/death).
+// Also compares batched scheduling (SCHEDULER_BATCH_SIZE) against per-step draws: throughput, and how far each mode's
+// per-slot run frequencies stray from the expected frequencies (total variation distance), and what fraction of pre-drawn
+// items batching throws away (discard rate).
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include "emp/base/vector.hpp"
+
+#include "emp/datastructs/IndexMap.hpp"
+#include "emp/math/Random.hpp"
+
+#include "dirdevo/utility/ProbabilisticScheduler.hpp"
+#include "dirdevo/utility/FenwickWeightMap.hpp"
+
+constexpr size_t DRAWS = 10000000;
+constexpr size_t DRAWS_PER_ADJUSTMENT = 30;
+
+template<typename SCHEDULER_T>
+void Bench(const std::string& name, size_t num_slots, size_t batch_size=0, bool sort_batch=false) {
+  emp::Random random(1);
+  SCHEDULER_T scheduler(random, num_slots);
+  scheduler.ConfigureBatching(batch_size, sort_batch);
+  for (size_t i = 0; i < num_slots; ++i) {
+    scheduler.AdjustWeight(i, random.GetDouble(0.5, 2.0));
+  }
+  size_t checksum = 0;
+  const auto start_time = std::chrono::steady_clock::now();
+  for (size_t draw = 0; draw < DRAWS; ++draw) {
+    checksum += scheduler.GetNext();
+    if (!(draw % DRAWS_PER_ADJUSTMENT)) {
+      scheduler.AdjustWeight(random.GetUInt(num_slots), random.GetDouble(0.5, 2.0));
+    }
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  std::cout << name << "," << num_slots << "," << (double)DRAWS / seconds << "," << checksum << std::endl;
+}
+
+/// Run DRAWS scheduled steps (with a weight adjustment every DRAWS_PER_ADJUSTMENT steps) and report the total variation
+/// distance between observed per-slot run frequencies and expected frequencies (given the weights at the time of each draw).
+void CompareStatistics(const std::string& name, size_t num_slots, size_t batch_size, bool sort_batch) {
+  emp::Random random(1);
+  emp::Random adjust_random(2); // Same weight adjustments regardless of how many draws the scheduler makes.
+  dirdevo::ProbabilisticScheduler scheduler(random, num_slots);
+  scheduler.ConfigureBatching(batch_size, sort_batch);
+  emp::vector<double> weights(num_slots);
+  for (size_t i = 0; i < num_slots; ++i) {
+    weights[i] = adjust_random.GetDouble(0.5, 2.0);
+    scheduler.AdjustWeight(i, weights[i]);
+  }
+  emp::vector<double> observed(num_slots, 0);
+  emp::vector<double> expected(num_slots, 0);
+  size_t draws_since_adjust = 0;
+  auto accumulate_expected = [&]() {
+    double total = 0;
+    for (double w : weights) total += w;
+    for (size_t i = 0; i < num_slots; ++i) expected[i] += draws_since_adjust * weights[i] / total;
+    draws_since_adjust = 0;
+  };
+  for (size_t draw = 0; draw < DRAWS / 10; ++draw) {
+    observed[scheduler.GetNext()] += 1;
+    ++draws_since_adjust;
+    if (!(draw % DRAWS_PER_ADJUSTMENT)) {
+      accumulate_expected();
+      const size_t slot = adjust_random.GetUInt(num_slots);
+      weights[slot] = adjust_random.GetDouble(0.5, 2.0);
+      scheduler.AdjustWeight(slot, weights[slot]);
+    }
+  }
+  accumulate_expected();
+  double tv_distance = 0;
+  for (size_t i = 0; i < num_slots; ++i) tv_distance += std::abs(observed[i] - expected[i]);
+  tv_distance /= 2.0 * (DRAWS / 10);
+  const double discard_rate = (scheduler.GetBatchDraws()) ? (double)scheduler.GetBatchDiscards() / scheduler.GetBatchDraws() : 0.0;
+  std::cout << name << "," << num_slots << "," << batch_size << "," << sort_batch << "," << tv_distance << "," << discard_rate << std::endl;
+}
+
+int main() {
+  std::cout << "backend,slots,draws_per_second,checksum" << std::endl;
+  for (size_t num_slots : {100, 10000, 1000000}) {
+    Bench<dirdevo::BasicProbabilisticScheduler<emp::IndexMap>>("IndexMap", num_slots);
+    Bench<dirdevo::BasicProbabilisticScheduler<dirdevo::FenwickWeightMap>>("Fenwick", num_slots);
+    Bench<dirdevo::ProbabilisticScheduler>("batched-64", num_slots, 64);
+    Bench<dirdevo::ProbabilisticScheduler>("batched-64-sorted", num_slots, 64, true);
+  }
+
+  std::cout << std::endl << "mode,slots,batch_size,sorted,tv_distance_from_expected,discard_rate" << std::endl;
+  for (size_t num_slots : {100, 1000}) {
+    CompareStatistics("per-step", num_slots, 0, false);
+    CompareStatistics("batched", num_slots, 64, false);
+    CompareStatistics("batched-sorted", num_slots, 64, true);
+  }
+  return 0;
+}
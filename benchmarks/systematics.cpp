@@ -0,0 +1,81 @@
+// Measures the cost of phylogeny tracking: runs identical AvidaGP worlds with and without systematics tracking
+// and reports the relative slowdown. (Systematics tracking doesn't touch the world's random number generator,
+// so both runs simulate exactly the same births and deaths.)
+
+#include <chrono>
+#include <iostream>
+
+#include "emp/base/Ptr.hpp"
+#include "emp/math/Random.hpp"
+
+#include "dirdevo/DirectedDevoConfig.hpp"
+#include "dirdevo/DirectedDevoWorld.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPOrganism.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPMultiPathwayTask.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPMutator.hpp"
+
+using org_t = dirdevo::AvidaGPOrganism;
+using task_t = dirdevo::AvidaGPMultiPathwayTask;
+using mutator_t = dirdevo::AvidaGPMutator;
+using world_t = dirdevo::DirectedDevoWorld<org_t,task_t>;
+using systematics_t = typename world_t::systematics_t;
+
+constexpr size_t UPDATES = 2000;
+constexpr size_t REPS = 3;
+
+/// Run a single world forward UPDATES updates; returns wall-clock seconds spent running the world.
+double RunWorld(const dirdevo::DirectedDevoConfig& config, bool track_systematics) {
+  emp::Random random(config.SEED());
+  emp::Ptr<systematics_t> systematics = nullptr;
+  double run_time = 0;
+  {
+    world_t world(config, random, "bench_world", 0);
+    world.SetAvgOrgStepsPerUpdate(config.AVG_STEPS_PER_ORG());
+    mutator_t mutator;
+    mutator_t::Configure(mutator, config);
+    world.SetMutFun([&mutator](org_t& org, emp::Random& rnd) {
+      return dirdevo::MutateOrganism(mutator, org, rnd);
+    });
+    if (track_systematics) {
+      systematics = emp::NewPtr<systematics_t>(world_t::CalcSystematicsInfo);
+      systematics->SetTrackSynchronous(false);
+      world.SetSharedSystematics(systematics, world.GetSize());
+    }
+    world.InjectAt(org_t::GenerateAncestralGenome(world, world), 0);
+    world.SyncSchedulerWeights();
+
+    const auto start_time = std::chrono::steady_clock::now();
+    for (size_t u = 0; u < UPDATES; ++u) {
+      world.RunStep();
+      world.Update();
+    }
+    world.FlushSharedSystematics();
+    run_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    if (systematics) {
+      std::cout << "  taxa=" << systematics->GetNumActive() << " total_orgs=" << systematics->GetTotalOrgs() << std::endl;
+    }
+  }
+  if (systematics) systematics.Delete();
+  return run_time;
+}
+
+int main() {
+  dirdevo::DirectedDevoConfig config;
+  config.SEED(2);
+  config.AVIDAGP_ENV_FILE("../tests/example-environment.json");
+
+  double untracked_time = 0;
+  double tracked_time = 0;
+  for (size_t rep = 0; rep < REPS; ++rep) {
+    untracked_time += RunWorld(config, false);
+    tracked_time += RunWorld(config, true);
+  }
+  untracked_time /= REPS;
+  tracked_time /= REPS;
+
+  std::cout << "updates: " << UPDATES << std::endl;
+  std::cout << "untracked (s): " << untracked_time << std::endl;
+  std::cout << "tracked (s): " << tracked_time << std::endl;
+  std::cout << "systematics overhead: " << 100.0 * (tracked_time - untracked_time) / untracked_time << "%" << std::endl;
+  return 0;
+}
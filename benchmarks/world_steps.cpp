@@ -0,0 +1,95 @@
+// Measures raw world throughput (organism steps per second) for the AvidaGP and OneMax setups.
+// Task and organism hooks are statically dispatched, and hooks left as base class no-ops are compiled out of the world
+// (see dirdevo/utility/hook_traits.hpp); this benchmark reports which hooks each setup actually pays for.
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "emp/math/Random.hpp"
+
+#include "dirdevo/DirectedDevoConfig.hpp"
+#include "dirdevo/DirectedDevoWorld.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPOrganism.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPMultiPathwayTask.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPMutator.hpp"
+#include "dirdevo/ExperimentSetups/OneMax/OneMaxOrganism.hpp"
+#include "dirdevo/ExperimentSetups/OneMax/OneMaxTask.hpp"
+#include "dirdevo/mutator/BitSetMutator.hpp"
+
+constexpr size_t UPDATES = 2000;
+constexpr size_t REPS = 3;
+
+template<typename WORLD_T>
+void PrintHooks(const std::string& name) {
+  using task_hooks_t = typename WORLD_T::task_hooks_t;
+  using org_hooks_t = typename WORLD_T::org_hooks_t;
+  std::cout << name << " task hooks:"
+            << " inject_ready=" << task_hooks_t::on_org_inject_ready
+            << " before_repro=" << task_hooks_t::on_before_org_repro
+            << " offspring_ready=" << task_hooks_t::on_offspring_ready
+            << " placement=" << task_hooks_t::on_org_placement
+            << " before_step=" << task_hooks_t::before_org_process_step
+            << " after_step=" << task_hooks_t::after_org_process_step
+            << " death=" << task_hooks_t::on_org_death
+            << " swap=" << task_hooks_t::after_org_swap << std::endl;
+  std::cout << name << " organism hooks:"
+            << " inject_ready=" << org_hooks_t::on_inject_ready
+            << " before_repro=" << org_hooks_t::on_before_repro
+            << " offspring_ready=" << org_hooks_t::on_offspring_ready
+            << " placement=" << org_hooks_t::on_placement
+            << " birth=" << org_hooks_t::on_birth
+            << " death=" << org_hooks_t::on_death << std::endl;
+}
+
+/// Run a single world forward UPDATES updates; returns organism steps per second.
+template<typename WORLD_T, typename MUTATOR_T>
+double RunWorld(const dirdevo::DirectedDevoConfig& config) {
+  using org_t = typename WORLD_T::org_t;
+  emp::Random random(config.SEED());
+  WORLD_T world(config, random, "bench_world", 0);
+  world.SetAvgOrgStepsPerUpdate(config.AVG_STEPS_PER_ORG());
+  MUTATOR_T mutator;
+  MUTATOR_T::Configure(mutator, config);
+  world.SetMutFun([&mutator](org_t& org, emp::Random& rnd) {
+    return dirdevo::MutateOrganism(mutator, org, rnd);
+  });
+  world.InjectAt(org_t::GenerateAncestralGenome(world, world), 0);
+  world.SyncSchedulerWeights();
+
+  size_t steps = 0;
+  const auto start_time = std::chrono::steady_clock::now();
+  for (size_t u = 0; u < UPDATES; ++u) {
+    steps += world.GetNumOrgs() * config.AVG_STEPS_PER_ORG();
+    world.RunStep();
+    world.Update();
+  }
+  const double run_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  return (double)steps / run_time;
+}
+
+template<typename WORLD_T, typename MUTATOR_T>
+void Bench(const std::string& name, const dirdevo::DirectedDevoConfig& config) {
+  PrintHooks<WORLD_T>(name);
+  double steps_per_sec = 0;
+  for (size_t rep = 0; rep < REPS; ++rep) {
+    steps_per_sec += RunWorld<WORLD_T,MUTATOR_T>(config);
+  }
+  std::cout << name << " steps/sec: " << steps_per_sec / REPS << std::endl;
+}
+
+int main() {
+  dirdevo::DirectedDevoConfig config;
+  config.SEED(2);
+  config.AVIDAGP_ENV_FILE("../tests/example-environment.json");
+
+  using avidagp_org_t = dirdevo::AvidaGPOrganism;
+  using avidagp_world_t = dirdevo::DirectedDevoWorld<avidagp_org_t, dirdevo::AvidaGPMultiPathwayTask>;
+  Bench<avidagp_world_t, dirdevo::AvidaGPMutator>("avidagp", config);
+
+  using onemax_org_t = dirdevo::OneMaxOrganism<256>;
+  using onemax_world_t = dirdevo::DirectedDevoWorld<onemax_org_t, dirdevo::OneMaxTask<onemax_org_t>>;
+  Bench<onemax_world_t, dirdevo::BitSetMutator>("onemax", config);
+
+  return 0;
+}
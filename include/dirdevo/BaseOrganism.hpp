@@ -7,6 +7,8 @@
 namespace dirdevo {
 
 /// BaseOrganism exists to remind me & enforce what I require organism classes to implement...
+/// Event hooks are statically dispatched (derived organisms hide them) and default to no-ops; the world doesn't call hooks that a
+/// derived organism leaves alone (see OrganismHookTraits).
 template<typename DERIVED_T>
 class BaseOrganism {
 public:
@@ -24,8 +26,6 @@ protected:
 
 public:
 
-  virtual ~BaseOrganism() = default;
-
   double GetMerit() const { return merit; }
   bool GetNewBorn() const { return new_born; }
   bool GetDead() const { return dead; }
@@ -40,6 +40,16 @@ public:
   void SetReproReady(bool r) { repro_ready = r; }
   void SetIsParent(bool p) { is_parent = p; }
 
+  /// Reset base organism state to that of a newly constructed organism (for organisms that get recycled in place).
+  void ResetBaseOrganism() {
+    merit=1.0;
+    new_born=false;
+    dead=false;
+    repro_ready=false;
+    is_parent=false;
+    world_id=0;
+  }
+
   /**
    * Derived organisms need to implement a ProcessStep function:
    *   template<typename WORLD_T>
@@ -49,25 +59,25 @@ public:
    */
 
   /// Called when this organism is about to be injected into the population.
-  virtual void OnInjectReady() { emp_assert(false, "Derived task class must implement this function."); }
+  void OnInjectReady() { }
 
   /// Called when this organism is about to reproduce (but offspring has not been built yet)
-  virtual void OnBeforeRepro() { emp_assert(false, "This function must be implemented by derived organism class."); }
+  void OnBeforeRepro() { }
 
   /// Called when this organism's offspring is ready (after the offspring's OnBirth function is called)
-  virtual void OnOffspringReady(DERIVED_T& offspring) { emp_assert(false, "This function must be implemented by derived organism class."); }
+  void OnOffspringReady(DERIVED_T& offspring) { }
 
   /// Called when *this* organism is placed (just after birth or injection)
-  virtual void OnPlacement(size_t position) { emp_assert(false, "This function must be implemented by derived organism class."); }
+  void OnPlacement(size_t position) { }
 
   /// Called when *this* organism is born
   /// - when world's offspring ready signal is triggered
   /// - after mutations
-  virtual void OnBirth(DERIVED_T& parent) { emp_assert(false, "This function must be implemented by derived organism class."); }
+  void OnBirth(DERIVED_T& parent) { }
 
   /// Called when *this* organism is being 'killed' by the world (in most cases, this won't do anything)
   /// - Position is the position in the world where the organism is being removed
-  virtual void OnDeath(size_t position) { emp_assert(false, "This function must be implemented by the derived organism class."); }
+  void OnDeath(size_t position) { }
 
 };
 
@@ -4,6 +4,7 @@
 
 #include <cstddef>
 #include <functional>
+#include <limits>
 
 #include "emp/base/vector.hpp"
 
@@ -12,10 +13,11 @@
 
 namespace dirdevo {
 
-// TODO - at compile time, depending on the task strip out unused function calls from the world?
-
 /// Tasks describe the world-level task. Organism-level "task" (i.e., how organisms reproduce/compete within a world is defined by the organism).
 /// This BaseTask design intends for derived tasks to ONLY work with a dirdevo::DirectedDevoWorld!
+/// Hooks are statically dispatched: derived tasks hide (rather than override) the functions below.
+/// - World-level hooks must be implemented by derived tasks.
+/// - Organism-level hooks default to no-ops. The world detects (at compile time) which ones a derived task leaves alone and doesn't call them at all.
 template<typename DERIVED_T, typename ORG_T>
 class BaseTask {
 
@@ -45,51 +47,55 @@ public:
 
   // --- WORLD-LEVEL EVENT HOOKS ---
 
-  virtual emp::vector<ConfigSnapshotEntry> GetConfigSnapshotEntries() { return {}; } // By default, return an empty vector.
+  emp::vector<ConfigSnapshotEntry> GetConfigSnapshotEntries() { return {}; } // By default, return an empty vector.
 
   /// OnWorldSetup called at end of constructor/world setup
-  virtual void OnWorldSetup() { emp_assert(false, "Derived task class must implement this function."); }
+  void OnWorldSetup() { emp_assert(false, "Derived task class must implement this function."); }
 
   /// OnBeforeWorldUpdate is called at the beginning of running the world update
-  virtual void OnBeforeWorldUpdate(size_t update) { emp_assert(false, "Derived task class must implement this function."); }
+  void OnBeforeWorldUpdate(size_t update) { emp_assert(false, "Derived task class must implement this function."); }
 
   /// OnWorldUpdate is called when the OnUpdate signal is triggered (at the end of a world update)
-  virtual void OnWorldUpdate(size_t update) { emp_assert(false, "Derived task class must implement this function."); }
+  void OnWorldUpdate(size_t update) { emp_assert(false, "Derived task class must implement this function."); }
 
   /// OnWorldReset is called when the DirectedDevoWorld's DirectedDevoReset function is called.
-  virtual void OnWorldReset() { emp_assert(false, "Derived task class must implement this function."); }
+  void OnWorldReset() { emp_assert(false, "Derived task class must implement this function."); }
 
   // TODO - any selection based hooks!
   /// Ensure that task performance is up-to-date. Might not do anything if performance is updated as the world updates.
-  virtual void Evaluate() { emp_assert(false, "Derived task class must implement this function."); }
+  void Evaluate() { emp_assert(false, "Derived task class must implement this function."); }
 
   // --- ORGANISM-LEVEL EVENT HOOKS ---
   // These are always called AFTER the organism's equivalent functions.
+  // No-ops by default (see TaskHookTraits).
 
   /// Called before an organism is injected into the population
-  virtual void OnOrgInjectReady(org_t& org) { emp_assert(false, "Derived task class must implement this function."); }
+  void OnOrgInjectReady(org_t& org) { }
 
-  // NOTE - Asserts are a lazy way to indicate to future me that these functions need to be implemented.
   /// Called when parent is about to reproduce, but before an offspring has been constructed.
-  virtual void OnBeforeOrgRepro(org_t & parent) { emp_assert(false, "Derived task class must implement this function."); }
+  void OnBeforeOrgRepro(org_t & parent) { }
 
   /// Called when the offspring has been constructed but has not been placed yet.
-  virtual void OnOffspringReady(org_t& offspring, org_t& parent) { emp_assert(false, "Derived task class must implement this function."); }
+  void OnOffspringReady(org_t& offspring, org_t& parent) { }
 
   /// Called when org is being placed (@ position) in the world
-  virtual void OnOrgPlacement(org_t& org, size_t position) { emp_assert(false, "Derived task class must implement this function."); }
+  void OnOrgPlacement(org_t& org, size_t position) { }
 
   /// Called just before the organism's process step function is called.
-  virtual void BeforeOrgProcessStep(org_t& org) { emp_assert(false, "Derived task class must implement this function."); }
+  void BeforeOrgProcessStep(org_t& org) { }
 
   /// Called just after the organism's process step function is called.
-  virtual void AfterOrgProcessStep(org_t& org) { emp_assert(false, "Derived task class must implement this function."); }
+  void AfterOrgProcessStep(org_t& org) { }
+
+  /// How many more steps can org take before AfterOrgProcessStep would kill it? The world caps time slices at this, so
+  /// task-imposed lifetimes hold exactly however long slices are. Unlimited by default.
+  size_t GetOrgStepsRemaining(const org_t& org) const { return std::numeric_limits<size_t>::max(); }
 
   /// Called before organism is removed from the world.
-  virtual void OnOrgDeath(org_t& org, size_t position) { emp_assert(false, "Derived task class must implement this function."); }
+  void OnOrgDeath(org_t& org, size_t position) { }
 
   /// Called after two organisms are swapped in the world (new world positions are accurate).
-  virtual void AfterOrgSwap(org_t& org1, org_t& org2) { emp_assert(false, "Derived task class must implement this function."); }
+  void AfterOrgSwap(org_t& org1, org_t& org2) { }
 
 };
 
@@ -13,6 +13,10 @@ EMP_BUILD_CONFIG(DirectedDevoConfig,
   VALUE(EPOCHS, size_t, 100, "Number of iterations of population-level selection to perform."),
   VALUE(LOAD_ANCESTOR_FROM_FILE, bool, false, "Should the ancestral genome be loaded from file? NOTE - the experiment setup must implement this functionality."),
   VALUE(ANCESTOR_FILE, std::string, "ancestor.gen", "Path to file containing ancestor genome to be loaded"),
+  VALUE(NUM_THREADS, size_t, 0, "How many threads to use when running worlds? 0 = use all hardware threads. (only used when compiled with threading flag)"),
+  VALUE(THREAD_SCHEDULER, std::string, "pool", "How are worlds scheduled onto threads? Options: pool (one job per world), work-stealing (worlds run in chunks of updates that idle threads can steal). (only used when compiled with threading flag)"),
+  VALUE(WORK_STEALING_CHUNK_UPDATES, size_t, 10, "(work-stealing scheduler) How many world updates are run per chunk? Must be >= 1."),
+  VALUE(PIPELINE_EPOCHS, bool, false, "Evaluate, sample, reset, and reseed worlds in parallel (fusing each world's reset/reseed with its next epoch) so only selection runs serially? (only used when compiled with threading flag)"),
 
   GROUP(OUTPUT_SETTINGS, "Settings specific to experiment output"),
   VALUE(OUTPUT_DIR, std::string, "output", "Where should the experiment dump output?"),
@@ -20,11 +24,17 @@ EMP_BUILD_CONFIG(DirectedDevoConfig,
   VALUE(OUTPUT_SUMMARY_EPOCH_RESOLUTION, size_t, 1, "Epoch resolution for recording summary data"),
   VALUE(OUTPUT_SUMMARY_UPDATE_RESOLUTION, size_t, 100, "Output resolution for recording summary data"),
   VALUE(OUTPUT_PHYLOGENY_SNAPSHOT_EPOCH_RESOLUTION, size_t, 10, "How often to output a snapshot of the phylogeny?"),
+  VALUE(OUTPUT_PHYLOGENY_SNAPSHOT_FORMAT, std::string, "csv", "Options: csv (write the full phylogeny to phylogeny_<epoch>.csv), incremental (append changes since the last snapshot to phylogeny.ddphylo; use phylogeny-reader to reconstruct any snapshot as CSV)"),
   VALUE(OUTPUT_SYSTEMATICS_EPOCH_RESOLUTION, size_t, 1, "Interval (in epochs) to output to systematics file"),
+  VALUE(OUTPUT_COLLECT_WORLD_TIMING, bool, false, "Collect per-world run times (wall clock) each recorded epoch?"),
   VALUE(TRACK_SYSTEMATICS, bool, true, "Should we enable systematics tracking?"),
 
   GROUP(LOCAL_WORLD_SETTINGS, "Settings for each local population (world)"),
   VALUE(AVG_STEPS_PER_ORG, size_t, 30, "On average, how many steps per organism do we allot on each world update? Must be >= 1."),
+  VALUE(SCHEDULER_TIME_SLICE, size_t, 1, "Maximum number of consecutive steps an organism runs each time it is scheduled (task step hooks run once per slice; slices stop early at task-imposed lifetimes, e.g., AVIDAGP_ORG_AGE_LIMIT). Must be >= 1."),
+  VALUE(SCHEDULER_BATCH_SIZE, size_t, 0, "How many organism steps should the scheduler draw at a time? (0 = draw one at a time) When a birth/death changes scheduler weights, the rest of the batch is corrected (dead/weakened organisms thinned, newborns drawn in) rather than redrawn."),
+  VALUE(SCHEDULER_BATCH_SORT, bool, false, "Sort each batch of scheduled organisms by position? Better memory locality; weight changes are corrected for the same way as unsorted batches."),
+  VALUE(ORGANISM_POOLING, bool, true, "Recycle organisms (and their allocated buffers) when they're removed from a world instead of freeing them? Only applies when world events are dispatched directly (the default)."),
   VALUE(UPDATES_PER_EPOCH, size_t, 100, "How many updates should we run each local population for during an period of evolution?"),
   VALUE(LOCAL_POP_STRUCTURE, std::string, "mixed", "Options: mixed, grid, grid3d"),
   VALUE(LOCAL_GRID_WIDTH, size_t, 10, "Grid width"),
@@ -38,6 +48,9 @@ EMP_BUILD_CONFIG(DirectedDevoConfig,
   VALUE(POPULATION_SAMPLING_METHOD, std::string, "random", "What method to use when sampling genomes to form propagules? Options: random, full"),
   VALUE(POPULATION_SAMPLING_SIZE, size_t, 1, "How many genomes to sample from each population when forming propagules (after population selection)?"),
 
+  GROUP(MUTATION_SETTINGS, "Settings shared by mutators"),
+  VALUE(MUTATION_SAMPLING, std::string, "per-site", "How do mutators pick sites to mutate? Options: per-site (one random draw per site; the original behavior), skip (draw the gap to the next mutated site from a geometric distribution; same per-site distribution, far fewer draws at low rates)"),
+
   GROUP(BITSET_GENOME_SETTINGS, "Settings specific to bitset genomes"),
   VALUE(BITSET_MUTATOR_PER_SITE_SUBSTITUTION_RATE, double, 0.01, "Per-site substitution rate for bitset genomes"),
   // GROUP(ONEMAX_ORG_SETTINGS, "Settings specific to the onemax organism"),
@@ -52,7 +65,10 @@ EMP_BUILD_CONFIG(DirectedDevoConfig,
   GROUP(AVIDAGP_ENV_SETTINGS, "Settings specific to AvidaGP environment/task"),
   VALUE(AVIDAGP_UNIQUE_ENV_OUTPUT, bool, true, "Should each environment input buffer result in unique output for all environment tasks?"),
   VALUE(AVIDAGP_ENV_FILE, std::string, "environment.json", "Path to the environment file that specifies which tasks are rewarded at organism and world level"),
-  VALUE(AVIDAGP_ENV_BANK_SIZE, size_t, 10000, "How many possible local environments to generate for each world?")
+  VALUE(AVIDAGP_ENV_BANK_SIZE, size_t, 10000, "How many possible local environments to generate for each world?"),
+  VALUE(AVIDAGP_SHARED_ENV_BANK, bool, true, "Should all worlds share one (read-only) environment bank per pathway? (requires the AvidaGP experiment peripheral; otherwise, each world generates its own)"),
+  VALUE(AVIDAGP_ENV_BANK_SEED, int, -1, "Seed used to generate shared environment banks (-1: use SEED). Set this to share prebuilt bank files across replicates."),
+  VALUE(AVIDAGP_ENV_BANK_DIR, std::string, "", "Directory of prebuilt environment bank files (see envbank-gen); empty: always generate banks at startup")
 
 
 );
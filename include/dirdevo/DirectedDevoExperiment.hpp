@@ -14,6 +14,7 @@
 #include <unordered_set>
 #include <functional>
 #include <filesystem>
+#include <chrono>
 #include <sys/stat.h>
 
 #include "emp/base/vector.hpp"
@@ -25,15 +26,21 @@
 
 #include "DirectedDevoConfig.hpp"
 #include "DirectedDevoWorld.hpp"
-#include "BasePeripheral.hpp"             /// TODO - fully integrate the peripheral component!
+#include "BasePeripheral.hpp"
 #include "selection/SelectionSchemes.hpp"
 #include "selection/BaseSelect.hpp"
 #include "utility/ConfigSnapshotEntry.hpp"
+#include "utility/GenomeInternTable.hpp"
+#include "utility/HashedGenome.hpp"
+#include "utility/PhylogenyLog.hpp"
+#include "utility/MutationDelta.hpp"
 #include "utility/WorldAwareDataFile.hpp"
 
 #ifdef DIRDEVO_THREADING
 #include <thread>
 #include <mutex>
+#include "utility/ThreadPool.hpp"
+#include "utility/WorkStealingExecutor.hpp"
 #endif // DIRDEVO_THREADED
 
 namespace dirdevo {
@@ -62,9 +69,11 @@ public:
   using mutator_t = MUTATOR;
   using genome_t = typename org_t::genome_t;
   using propagule_t = emp::vector<TransferOrg>;
+  using genome_table_t = GenomeInternTable<genome_t>;
+  using genome_handle_t = typename genome_table_t::handle_t;
 
-  // TODO - add mutation tracking to systematics?
-  using systematics_t = emp::Systematics<org_t, genome_t>;
+  using systematics_t = typename world_t::systematics_t;
+  using taxon_t = typename systematics_t::taxon_t;
 
   const std::unordered_set<std::string> valid_selection_methods={
     "elite",
@@ -81,10 +90,15 @@ public:
     "full"
   };
 
+  const std::unordered_set<std::string> valid_thread_schedulers={
+    "pool",
+    "work-stealing"
+  };
+
   /// Propagules are vectors of TransferGenomes. A TransferGenome wraps information about the genomes sampled to form propagules.
   /// Necessary for stitching together phylogeny tracking across transfers.
   struct TransferOrg {
-    emp::Ptr<org_t> org;
+    genome_handle_t genome=genome_table_t::NO_HANDLE; ///< Handle into the experiment's genome table.
     size_t original_pos=0;
     size_t transfer_pos=0;
   };
@@ -105,20 +119,36 @@ protected:
 
   emp::Ptr<BaseSelect> selector=nullptr;
 
+  #ifdef DIRDEVO_THREADING
+  emp::Ptr<ThreadPool> thread_pool=nullptr;     ///< Long-lived worker threads used to run worlds each epoch (THREAD_SCHEDULER=pool).
+  emp::Ptr<WorkStealingExecutor> work_stealing_executor=nullptr; ///< Used instead of thread_pool when THREAD_SCHEDULER=work-stealing.
+  #endif // DIRDEVO_THREADING
+
   std::function<emp::vector<size_t>&(void)> do_selection_fun;
   emp::vector<std::function<double(void)>> aggregate_score_funs;          ///< One function for each world.
   emp::vector< emp::vector<std::function<double(void)>> > score_fun_sets; ///< One set of functions for each world. Where each function corresponds to a single objective.
 
   std::function<void(world_t&,propagule_t&)> propagule_sample_fun;
+  genome_table_t genome_table;                ///< Interned genomes (shared by propagules and interaction matrices).
+  emp::Ptr<org_t> transfer_org_proxy=nullptr; ///< Scratch organism used to hand transfer genomes to the systematics manager.
   emp::vector<propagule_t> propagules;
   std::unordered_set<size_t> extinct_worlds;        ///< Set of worlds that are extinct.
   std::unordered_set<size_t> live_worlds;           ///< Set of worlds that are not extinct.
-  emp::vector<size_t> population_sample_order;
+  emp::vector<emp::vector<size_t>> population_sample_orders; ///< Scratch space for random propagule sampling (one shared order, or one per world when sampling in parallel).
+
+  bool pipeline_epochs=false;  ///< Run per-world evaluation, sampling, reset, and reseeding in parallel? (see PIPELINE_EPOCHS)
+  bool reseed_pending=false;   ///< (pipelined epochs) Worlds still need to be reset + seeded with propagules before they run.
 
-  emp::map<typename emp::World<ORG>::genome_t, size_t> genomes_seen; // Sydney: store genomes for mapping ids
+  std::unordered_map<genome_handle_t, size_t> genomes_seen; // Sydney: store genomes for mapping ids (holds a genome table reference to each genome)
   emp::map<size_t, emp::map<size_t, float>> interaction_matrix; // Sydney: store interaction matrix for a given world_id and epoch
   size_t interaction_matrix_world_id; // Sydney: for data file
 
+  emp::vector<double> world_run_times;  ///< Wall-clock time (seconds) each world spent running during the current epoch.
+  double epoch_run_time=0;              ///< Wall-clock time (seconds) to run all worlds during the current epoch.
+  size_t epoch_run_chunks=0;            ///< Number of update chunks run this epoch (work-stealing scheduler only).
+  size_t epoch_run_steals=0;            ///< Number of update chunks stolen by another thread this epoch (work-stealing scheduler only).
+  size_t timing_world_id=0;             ///< For world timing data file
+
   size_t max_world_size=0;
   bool setup=false;
   size_t cur_epoch=0;
@@ -128,8 +158,12 @@ protected:
   emp::Ptr<emp::DataFile> world_evaluation_file=nullptr;  ///< Manages world evaluation output. (is updated after each world's evaluation)
   emp::Ptr<emp::DataFile> world_systematics_file=nullptr; ///<
   emp::Ptr<emp::DataFile> interaction_matrices_file=nullptr; ///< Sydney: stores interaction matrices
+  emp::Ptr<emp::DataFile> world_timing_file=nullptr;      ///< Per-world run times (for spotting load imbalance between worlds)
 
   std::string output_dir;                     ///< Formatted output directory
+  bool incremental_phylogeny=false;           ///< Write phylogeny snapshots to phylogeny_log (rather than full CSV snapshots)?
+  PhylogenyLogWriter phylogeny_log;           ///< Incremental phylogeny snapshots (see OUTPUT_PHYLOGENY_SNAPSHOT_FORMAT)
+  std::unordered_set<taxon_t*> phylogeny_dirty_taxa; ///< Taxa whose counts may have changed since the last phylogeny_log snapshot
 
   /// Setup the experiment based on the given configuration (called internally).
   void Setup();
@@ -140,6 +174,9 @@ protected:
   /// Configure population selection (called internally).
   void SetupSelection();
   void SetupSystematics();
+
+  /// Replay any systematics events that worlds have logged (in world order) on the shared systematics manager.
+  void FlushSystematics();
   void SetupEliteSelection();
   void SetupTournamentSelection();
   void SetupLexicaseSelection();
@@ -160,6 +197,18 @@ protected:
 
   void SeedWithPropagule(world_t& world, propagule_t& propagule);
 
+  /// Fill propagules with samples from each selected world (falls over to the next live world if a selected world is extinct).
+  void SamplePropagules(const emp::vector<size_t>& selected);
+
+  /// Clear out the given world and seed it with its propagule.
+  void ResetAndSeedWorld(size_t world_id);
+
+  /// Release every propagule genome still held in the genome table.
+  void ReleasePropagules();
+
+  /// Call fun(world_id) for every world; runs on the thread pool when compiled with threading.
+  void ForEachWorld(const std::function<void(size_t)>& fun);
+
   /// Output the experiment's configuration as a .csv file.
   void SnapshotConfig(const std::string& filename = "experiment-config.csv");
 
@@ -189,19 +238,23 @@ public:
     if (world_evaluation_file) world_evaluation_file.Delete();
     if (world_systematics_file) world_systematics_file.Delete();
     if (interaction_matrices_file) interaction_matrices_file.Delete(); // Sydney
+    if (world_timing_file) world_timing_file.Delete();
 
-    // Clean up any undeleted propagule organism pointers
-    for (propagule_t& propagule : propagules) {
-      for (size_t i = 0; i < propagule.size(); ++i) {
-        if (propagule[i].org) propagule[i].org.Delete();
-      }
-    }
+    // Clean up any unreleased propagule genomes
+    ReleasePropagules();
+    if (transfer_org_proxy) transfer_org_proxy.Delete();
 
     // Clean up the shared (between worlds) systematics manager
     if (systematics) systematics.Delete();
 
     // Clean up the selector
     if (selector) selector.Delete();
+
+    #ifdef DIRDEVO_THREADING
+    // Clean up the thread pool/executor (joins worker threads)
+    if (thread_pool) thread_pool.Delete();
+    if (work_stealing_executor) work_stealing_executor.Delete();
+    #endif // DIRDEVO_THREADING
   }
 
   /// Run experiment for configured number of EPOCHS
@@ -213,7 +266,7 @@ public:
   void RunStep();
 
   /// Sydney
-  emp::map<typename emp::World<ORG>::genome_t, float> GetWorldFitnesses(emp::map<typename emp::World<ORG>::genome_t, size_t> unique_genomes, size_t world_id, size_t remove_cell);
+  emp::map<typename emp::World<ORG>::genome_t, float> GetWorldFitnesses(const std::unordered_map<genome_handle_t, size_t>& unique_genomes, size_t world_id, size_t remove_cell);
 
   peripheral_t& GetPeripheral() { return peripheral; }
   const peripheral_t& GetPeripheral() const { return peripheral; }
@@ -259,6 +312,15 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::Setup() {
   for (auto seed : world_seeds) {
     world_rngs.emplace_back(seed);
   }
+  // Spin up worker threads once; they get reused every epoch.
+  if (config.THREAD_SCHEDULER() == "work-stealing") {
+    work_stealing_executor = emp::NewPtr<WorkStealingExecutor>(config.NUM_THREADS());
+    std::cout << "Running worlds on " << work_stealing_executor->GetNumThreads() << " threads (work stealing, ";
+    std::cout << config.WORK_STEALING_CHUNK_UPDATES() << " updates per chunk)." << std::endl;
+  } else {
+    thread_pool = emp::NewPtr<ThreadPool>(config.NUM_THREADS());
+    std::cout << "Running worlds on " << thread_pool->GetNumThreads() << " threads." << std::endl;
+  }
   #endif // DIRDEVO_THREADING
 
   // Initialize each world.
@@ -273,16 +335,23 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::Setup() {
       random,
       #endif // DIRDEVO_THREADING
       "world_"+emp::to_string(i),
-      i
+      i,
+      &peripheral
     );
     worlds[i]->SetAvgOrgStepsPerUpdate(config.AVG_STEPS_PER_ORG());
     // configure world's mutation function
     worlds[i]->SetMutFun([this, i](org_t & org, emp::Random& rnd) {
-      // TODO - add support for mutation tracking!
-      return mutators[i].Mutate(org.GetGenome(), rnd);
+      return MutateOrganism(mutators[i], org, rnd);
     });
     max_world_size = emp::Max(worlds[i]->GetSize(), max_world_size);
   }
+  world_run_times.resize(config.NUM_POPS(), 0);
+
+  #ifdef DIRDEVO_THREADING
+  pipeline_epochs = config.PIPELINE_EPOCHS();
+  #else
+  if (config.PIPELINE_EPOCHS()) std::cout << "PIPELINE_EPOCHS has no effect without threading enabled." << std::endl;
+  #endif // DIRDEVO_THREADING
 
   if (config.TRACK_SYSTEMATICS()) {
     SetupSystematics();
@@ -310,6 +379,7 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::Setup() {
     // auto ancestral_genome = ;
     world_ptr->InjectAt(get_ancestor_genome(*this, *world_ptr), 0); // TODO - Random location to start?
   }
+  FlushSystematics(); // Add every world's ancestor to the phylogeny before any world runs.
 
   // Adjust initial scheduler weights according to initial population!
   for (auto world_ptr : worlds) {
@@ -383,17 +453,22 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::SetupSelecti
 template <typename WORLD, typename ORG, typename MUTATOR, typename TASK, typename PERIPHERAL>
 void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::SetupPropaguleSampleMethod() {
 
-  population_sample_order.resize(max_world_size);
-  std::iota(
-    population_sample_order.begin(),
-    population_sample_order.end(),
-    0
-  );
+  // Pipelined epochs sample worlds in parallel, so each world needs its own sample order.
+  population_sample_orders.resize(pipeline_epochs ? worlds.size() : 1);
+  for (auto& sample_order : population_sample_orders) {
+    sample_order.resize(max_world_size);
+    std::iota(
+      sample_order.begin(),
+      sample_order.end(),
+      0
+    );
+  }
 
   if (config.POPULATION_SAMPLING_METHOD() == "random") {
     // Sample randomly
     propagule_sample_fun = [this](world_t& world, propagule_t& sample_into) {
       sample_into.clear();
+      auto& population_sample_order = population_sample_orders[pipeline_epochs ? world.GetWorldID() : 0];
       emp::Shuffle(world.GetRandom(), population_sample_order);
       // extinct worlds shouldn't get selected (unless everything went extinct or we're doing random selection...)
       for (size_t i = 0; (i < population_sample_order.size()) && (sample_into.size() < config.POPULATION_SAMPLING_SIZE()); ++i) {
@@ -403,7 +478,7 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::SetupPropagu
         // const size_t sampled_pos = world.GetRandomOrgID();
         const size_t world_pos_offset = world.GetSharedSystematics().offset; // 0 if not tracking systematics
         sample_into.emplace_back();
-        sample_into.back().org = emp::NewPtr<org_t>(world.GetOrg(sampled_pos).GetGenome());
+        sample_into.back().genome = genome_table.Intern(world.GetOrg(sampled_pos).GetGenome());
         sample_into.back().original_pos = world_pos_offset + sampled_pos;
       }
     };
@@ -417,7 +492,7 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::SetupPropagu
         const size_t sampled_pos = org_id;
         const size_t world_pos_offset = world.GetSharedSystematics().offset; // 0 if not tracking systematics
         sample_into.emplace_back();
-        sample_into.back().org = emp::NewPtr<org_t>(world.GetOrg(sampled_pos).GetGenome());
+        sample_into.back().genome = genome_table.Intern(world.GetOrg(sampled_pos).GetGenome());
         sample_into.back().original_pos = world_pos_offset + sampled_pos;
       }
     };
@@ -430,12 +505,56 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::SetupPropagu
 template <typename WORLD, typename ORG, typename MUTATOR, typename TASK, typename PERIPHERAL>
 void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::SetupSystematics() {
   // Configure systematics tracking (TODO - allow systematics tracking to be stripped out for performance)
-  systematics = emp::NewPtr<systematics_t>([](const org_t& org) { return org.GetGenome(); });
+  systematics = emp::NewPtr<systematics_t>(world_t::CalcSystematicsInfo);
   systematics->SetTrackSynchronous(false); // Tell systematics that we have asynchronous generations
   systematics->AddPairwiseDistanceDataNode();
   systematics->AddPhylogeneticDiversityDataNode();
+  const std::string& snapshot_format = config.OUTPUT_PHYLOGENY_SNAPSHOT_FORMAT();
+  if (snapshot_format != "incremental" && snapshot_format != "csv") {
+    std::cout << "Unknown phylogeny snapshot format: " << snapshot_format << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  incremental_phylogeny = snapshot_format == "incremental";
+  if (incremental_phylogeny) {
+    // Record phylogeny changes as they happen; each snapshot appends the changes since the last one (see Run).
+    // Taxon births, extinctions, and prunes change offspring counts up the lineage, so mark the lineage as dirty (its
+    // counts get logged at the next snapshot). Between snapshots, a dirty taxon's ancestors are all dirty, so the walk
+    // can stop at the first dirty one.
+    auto mark_lineage_dirty = [this](emp::Ptr<taxon_t> taxon) {
+      while (taxon && phylogeny_dirty_taxa.insert(taxon.Raw()).second) taxon = taxon->GetParent();
+    };
+    std::function<void(emp::Ptr<taxon_t>, org_t&)> on_new_taxon = [this, mark_lineage_dirty](emp::Ptr<taxon_t> taxon, org_t&) {
+      const uint64_t parent_id = (taxon->GetParent()) ? (uint64_t)taxon->GetParent()->GetID() : PhylogenyLogWriter::NO_PARENT;
+      phylogeny_log.AddTaxon(taxon->GetID(), parent_id, (int64_t)taxon->GetOriginationTime(), emp::to_string(taxon->GetInfo()));
+      mark_lineage_dirty(taxon);
+    };
+    std::function<void(emp::Ptr<taxon_t>)> on_extinct_taxon = [this, mark_lineage_dirty](emp::Ptr<taxon_t> taxon) {
+      phylogeny_log.SetDestructionTime(taxon->GetID(), (int64_t)taxon->GetDestructionTime());
+      mark_lineage_dirty(taxon);
+    };
+    std::function<void(emp::Ptr<taxon_t>)> on_prune_taxon = [this, mark_lineage_dirty](emp::Ptr<taxon_t> taxon) {
+      phylogeny_log.RemoveTaxon(taxon->GetID());
+      phylogeny_dirty_taxa.erase(taxon.Raw()); // Deleted once pruned.
+      mark_lineage_dirty(taxon->GetParent());
+    };
+    systematics->OnNew(on_new_taxon);
+    systematics->OnExtinct(on_extinct_taxon);
+    systematics->OnPrune(on_prune_taxon);
+  }
   for (auto world_ptr : worlds) {
     world_ptr->SetSharedSystematics(systematics, max_world_size);
+    #ifdef DIRDEVO_THREADING
+    // Worlds run in parallel, so their systematics event logs are replayed (in world order) between parallel phases.
+    world_ptr->SetSharedSystematicsFlushOnUpdate(false);
+    #endif // DIRDEVO_THREADING
+  }
+}
+
+template <typename WORLD, typename ORG, typename MUTATOR, typename TASK, typename PERIPHERAL>
+void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::FlushSystematics() {
+  if (!config.TRACK_SYSTEMATICS()) return;
+  for (auto world_ptr : worlds) {
+    world_ptr->FlushSharedSystematics();
   }
 }
 
@@ -448,6 +567,7 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::SetupDataCol
     if (world_evaluation_file) world_evaluation_file.Delete();
     if (world_systematics_file) world_systematics_file.Delete();
     if (interaction_matrices_file) interaction_matrices_file.Delete(); // Sydney
+    if (world_timing_file) world_timing_file.Delete();
   } else {
     mkdir(output_dir.c_str(), ACCESSPERMS);
     if(output_dir.back() != '/') {
@@ -568,6 +688,27 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::SetupDataCol
 
   world_evaluation_file->PrintHeaderKeys();
 
+  //////////////////////////////////
+  // WORLD TIMING
+  if (config.OUTPUT_COLLECT_WORLD_TIMING()) {
+    world_timing_file = emp::NewPtr<emp::DataFile>(output_dir + "world_timing.csv");
+    world_timing_file->AddFun<size_t>(get_epoch, "epoch");
+    world_timing_file->AddVar(timing_world_id, "world_id");
+    world_timing_file->AddFun<size_t>(
+      [this]() { return worlds[timing_world_id]->GetNumOrgs(); },
+      "num_orgs"
+    );
+    world_timing_file->AddFun<double>(
+      [this]() { return world_run_times[timing_world_id]; },
+      "world_run_time",
+      "Wall-clock time (seconds) spent running this world during the epoch (summed over chunks)."
+    );
+    world_timing_file->AddVar(epoch_run_time, "epoch_run_time", "Wall-clock time (seconds) to run all worlds during the epoch.");
+    world_timing_file->AddVar(epoch_run_chunks, "epoch_run_chunks", "Update chunks run during the epoch (work-stealing scheduler only).");
+    world_timing_file->AddVar(epoch_run_steals, "epoch_run_steals", "Update chunks stolen by idle threads during the epoch (work-stealing scheduler only).");
+    world_timing_file->PrintHeaderKeys();
+  }
+
   //////////////////////////////////
   // Systematics
   if (config.TRACK_SYSTEMATICS()) {
@@ -585,6 +726,11 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::SetupDataCol
     world_systematics_file->AddCurrent(*systematics->GetDataNode("phylogenetic_diversity"), "genotype_current_phylogenetic_diversity", "current phylogenetic_diversity", true, true);
     // write file header
     world_systematics_file->PrintHeaderKeys();
+    // phylogeny snapshots (if incremental; the log keeps appending if data collection is set up again)
+    if (incremental_phylogeny && !phylogeny_log.IsOpen() && !phylogeny_log.Open(output_dir + "phylogeny.ddphylo")) {
+      std::cout << "Failed to open phylogeny log: " << output_dir << "phylogeny.ddphylo" << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
   }
 
 }
@@ -693,12 +839,79 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::SeedWithProp
   for (size_t i = 0; i < propagule.size(); ++i) {
    const size_t pos = i; // TODO - use a slightly better method of distributing the propagule!
    // need to set next parent
-   if (config.TRACK_SYSTEMATICS()) systematics->SetNextParent(propagule[i].transfer_pos);
-   world.InjectAt(propagule[i].org->GetGenome(), {pos});
+   if (config.TRACK_SYSTEMATICS()) world.GetSharedSystematics().SetNextParentExternal(propagule[i].transfer_pos);
+   world.InjectAt(genome_table.Get(propagule[i].genome), {pos});
   }
   world.SyncSchedulerWeights();
 }
 
+template <typename WORLD, typename ORG, typename MUTATOR, typename TASK, typename PERIPHERAL>
+void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::SamplePropagules(const emp::vector<size_t>& selected) {
+  emp_assert(propagules.size()==selected.size());
+  // Make sure each selected pop is isn't extinct (in some weird edge case)
+  // Note that we cannot be here if all populations are extinct. Spin until we pull a non-extinct pop.
+  emp::vector<size_t> source_worlds(selected);
+  for (size_t& source_id : source_worlds) {
+    while (emp::Has(extinct_worlds, source_id)) {
+      source_id = (source_id + 1) % worlds.size();
+    }
+  }
+
+  if (!pipeline_epochs) {
+    for (size_t i = 0; i < source_worlds.size(); ++i) {
+      // Sample from the selected world to form the propagule.
+      Sample(*worlds[source_worlds[i]], propagules[i]);
+    }
+    return;
+  }
+
+  // Sampling uses the source world's random number generator, so group propagules by source world and give
+  // each source world to a single thread.
+  emp::vector<emp::vector<size_t>> propagules_by_source(worlds.size());
+  for (size_t i = 0; i < source_worlds.size(); ++i) {
+    propagules_by_source[source_worlds[i]].emplace_back(i);
+  }
+  ForEachWorld([this, &propagules_by_source](size_t source_id) {
+    for (size_t prop_i : propagules_by_source[source_id]) {
+      Sample(*worlds[source_id], propagules[prop_i]);
+    }
+  });
+}
+
+template <typename WORLD, typename ORG, typename MUTATOR, typename TASK, typename PERIPHERAL>
+void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::ResetAndSeedWorld(size_t world_id) {
+  auto& world = *(worlds[world_id]);
+  world.DirectedDevoReset(); // Clear our the world.
+  emp_assert(propagules[world_id].size(), "Propagule is empty.");
+  SeedWithPropagule(world, propagules[world_id]); // NOTE - this will handle connecting injected organisms to transfer organisms in propagule
+}
+
+template <typename WORLD, typename ORG, typename MUTATOR, typename TASK, typename PERIPHERAL>
+void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::ReleasePropagules() {
+  for (propagule_t& propagule : propagules) {
+    for (TransferOrg& transfer_org : propagule) {
+      if (transfer_org.genome == genome_table_t::NO_HANDLE) continue;
+      genome_table.Release(transfer_org.genome);
+      transfer_org.genome = genome_table_t::NO_HANDLE;
+    }
+  }
+}
+
+template <typename WORLD, typename ORG, typename MUTATOR, typename TASK, typename PERIPHERAL>
+void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::ForEachWorld(const std::function<void(size_t)>& fun) {
+  #ifdef DIRDEVO_THREADING
+  if (work_stealing_executor) {
+    work_stealing_executor->ParallelFor(worlds.size(), fun);
+  } else {
+    thread_pool->ParallelFor(worlds.size(), fun);
+  }
+  #else
+  for (size_t world_id = 0; world_id < worlds.size(); ++world_id) {
+    fun(world_id);
+  }
+  #endif // DIRDEVO_THREADING
+}
+
 template <typename WORLD, typename ORG, typename MUTATOR, typename TASK, typename PERIPHERAL>
 void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::SnapshotConfig(
   const std::string& filename /*= "experiment-config.csv"*/
@@ -758,17 +971,13 @@ bool DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::ValidateConf
   if (config.LOCAL_GRID_HEIGHT() < 1) return false;
   if (config.LOCAL_GRID_DEPTH() < 1) return false;
   if (config.AVG_STEPS_PER_ORG() < 1) return false;
+  if (config.SCHEDULER_TIME_SLICE() < 1) return false;
   if (!emp::Has(valid_selection_methods,config.SELECTION_METHOD())) return false;
   if (config.POPULATION_SAMPLING_SIZE() < 1) return false;
+  if (!emp::Has(valid_thread_schedulers,config.THREAD_SCHEDULER())) return false;
+  if (config.WORK_STEALING_CHUNK_UPDATES() < 1) return false;
   // TODO - flesh this out!
 
-  #ifdef DIRDEVO_THREADING
-  if (config.TRACK_SYSTEMATICS()) {
-    std::cout << "Cannot track systematics if compiled with threading enabled." << std::endl;
-    return false;
-  }
-  #endif
-
   return true;
 }
 
@@ -777,13 +986,46 @@ template <typename WORLD, typename ORG, typename MUTATOR, typename TASK, typenam
 void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::Run() {
   // Create vector to hold the distribution of population ids selected each epoch
 
+  using run_clock_t = std::chrono::steady_clock;
+  using seconds_t = std::chrono::duration<double>;
+
+  // Pipelined epochs fold each world's reset + reseed into the job that runs it next epoch.
+  // (Unless we're tracking systematics: transfer organisms need to be removed from the phylogeny between reseeding and running.)
+  const bool fuse_reseed = pipeline_epochs && !config.TRACK_SYSTEMATICS();
+
   #ifdef DIRDEVO_THREADING
   std::function<void(size_t)> run_world = [this](size_t world_id) {
+    const auto start_time = run_clock_t::now();
+    if (reseed_pending) ResetAndSeedWorld(world_id);
     worlds[world_id]->SetEpoch(cur_epoch);
     for (size_t u = 0; u <= config.UPDATES_PER_EPOCH(); u++) {
       worlds[world_id]->RunStep();
       worlds[world_id]->Update();
     }
+    if (pipeline_epochs) worlds[world_id]->Evaluate();
+    world_run_times[world_id] = seconds_t(run_clock_t::now() - start_time).count();
+  };
+
+  // Work-stealing scheduler: each call runs the next chunk of updates for the given world.
+  // A world's chunks never run concurrently (the executor guarantees this), so per-world state needs no locking.
+  emp::vector<size_t> world_next_update(worlds.size(), 0);
+  std::function<bool(size_t)> run_world_chunk = [this, &world_next_update](size_t world_id) {
+    const auto start_time = run_clock_t::now();
+    auto& world = *(worlds[world_id]);
+    size_t& u = world_next_update[world_id];
+    if (!u) {
+      if (reseed_pending) ResetAndSeedWorld(world_id);
+      world.SetEpoch(cur_epoch);
+    }
+    const size_t chunk_end = emp::Min(u + config.WORK_STEALING_CHUNK_UPDATES(), config.UPDATES_PER_EPOCH() + 1);
+    for ( ; u < chunk_end; ++u) {
+      world.RunStep();
+      world.Update();
+    }
+    const bool more_updates = u <= config.UPDATES_PER_EPOCH();
+    if (!more_updates && pipeline_epochs) world.Evaluate();
+    world_run_times[world_id] += seconds_t(run_clock_t::now() - start_time).count();
+    return more_updates;
   };
   #endif // DIRDEVO_THREADING
 
@@ -800,20 +1042,30 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::Run() {
     const bool snapshot_phylogeny = config.TRACK_SYSTEMATICS() && (!(cur_epoch % config.OUTPUT_PHYLOGENY_SNAPSHOT_EPOCH_RESOLUTION()) || (cur_epoch == config.EPOCHS()));
     const bool record_systematics = config.TRACK_SYSTEMATICS() && (!(cur_epoch % config.OUTPUT_SYSTEMATICS_EPOCH_RESOLUTION()) || (cur_epoch == config.EPOCHS()));
 
+    std::fill(world_run_times.begin(), world_run_times.end(), 0);
+    epoch_run_chunks = 0;
+    epoch_run_steals = 0;
+    const auto epoch_start_time = run_clock_t::now();
+
     #ifdef DIRDEVO_THREADING
     ///////////////////////////////////////////////
     // THREADING ENABLED
-    emp::vector<std::thread> threads;
-    for (size_t world_id = 1; world_id < worlds.size(); ++world_id) {
-      threads.emplace_back(
-        run_world,
-        world_id
-      );
+    if (work_stealing_executor) {
+      // Each world's epoch is a sequence of update chunks; idle threads steal chunks from busy threads.
+      std::fill(world_next_update.begin(), world_next_update.end(), 0);
+      const auto stats = work_stealing_executor->Run(worlds.size(), run_world_chunk);
+      epoch_run_chunks = stats.chunks;
+      epoch_run_steals = stats.steals;
+    } else {
+      // Each world is a job for the thread pool (the main thread helps out while waiting on the pool).
+      thread_pool->ParallelFor(worlds.size(), run_world);
     }
-    run_world(0); // use the main thread to run world 0
-    // Join threads
-    for (auto& thread : threads) {
-      thread.join();
+    epoch_run_time = seconds_t(run_clock_t::now() - epoch_start_time).count();
+    FlushSystematics(); // Replay systematics events logged by worlds while running (in world order).
+    if (reseed_pending) {
+      // Worlds have been reseeded; we're done with last epoch's propagules.
+      ReleasePropagules();
+      reseed_pending = false;
     }
     // Update world summary file
     for (auto world_ptr : worlds) {
@@ -824,8 +1076,10 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::Run() {
     ///////////////////////////////////////////////
     // THREADING DISABLED
     // Run worlds forward X updates.
-    for (auto world_ptr : worlds) {
+    for (size_t world_id = 0; world_id < worlds.size(); ++world_id) {
+      auto world_ptr = worlds[world_id];
       std::cout << "Running world " << world_ptr->GetName() << std::endl;
+      const auto world_start_time = run_clock_t::now();
       world_ptr->SetEpoch(cur_epoch);
       for (size_t u = 0; u <= config.UPDATES_PER_EPOCH(); u++) {
         const bool record_update = config.OUTPUT_COLLECT_WORLD_UPDATE_SUMMARY() && (!(u % config.OUTPUT_SUMMARY_UPDATE_RESOLUTION()) || (u == config.UPDATES_PER_EPOCH()));
@@ -834,26 +1088,39 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::Run() {
         }
         world_ptr->Update();
       }
+      world_run_times[world_id] = seconds_t(run_clock_t::now() - world_start_time).count();
     }
+    epoch_run_time = seconds_t(run_clock_t::now() - epoch_start_time).count();
+    FlushSystematics(); // Catch any events logged since each world's last update.
     ///////////////////////////////////////////////
     #endif //DIRDEVO_THREADING
 
+    // Record world timing?
+    if (record_epoch && world_timing_file) {
+      for (timing_world_id = 0; timing_world_id < worlds.size(); ++timing_world_id) {
+        world_timing_file->Update();
+      }
+    }
+
     // Sydney: calculate interaction matrix
     if (cur_epoch == 499) { // TEMP
       for (size_t world_id = 0; world_id < worlds.size(); ++world_id) {
         interaction_matrix_world_id = world_id;
 
-        //get genomes in world
-        emp::map<typename emp::World<ORG>::genome_t, size_t> unique_genomes;
+        //get genomes in world (unique_genomes holds one genome table reference per genome)
+        std::unordered_map<genome_handle_t, size_t> unique_genomes;
         for (size_t i=0; i < worlds[world_id]->GetSize(); i++) {
           if (worlds[world_id]->IsOccupied(i)) {
-            typename emp::World<ORG>::genome_t org_genome = worlds[world_id]->GetOrg(i).GetGenome();
+            const genome_handle_t org_genome = genome_table.Intern(worlds[world_id]->GetOrg(i).GetGenome());
             if (unique_genomes.find(org_genome) == unique_genomes.end()) {
               unique_genomes.insert({org_genome, i});
+            } else {
+              genome_table.Release(org_genome);
             }
             //global mapping of genomes to ids
             if (genomes_seen.find(org_genome) == genomes_seen.end()) {
               genomes_seen.insert({org_genome, genomes_seen.size()});
+              genome_table.Retain(org_genome);
             }
           }
         }
@@ -868,24 +1135,37 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::Run() {
               interaction_matrix[genomes_seen[genome]][genomes_seen[remove_genome]] = 0;
             }
             else {
-              interaction_matrix[genomes_seen[genome]][genomes_seen[remove_genome]] = genome_fitnesses[genome] - default_fitnesses[genome];
+              const genome_t& full_genome = genome_table.Get(genome);
+              interaction_matrix[genomes_seen[genome]][genomes_seen[remove_genome]] = genome_fitnesses[full_genome] - default_fitnesses[full_genome];
             }
           }
         }
         interaction_matrices_file->Update();
+        for (auto& [genome, cell] : unique_genomes) {
+          genome_table.Release(genome);
+        }
       }
     }
 
     // Do evaluation (could move this into previous loop if I don't add anything else here that requires all worlds to have been run)
+    // - Pipelined epochs already evaluated each world at the end of its run.
     for (size_t world_id = 0; world_id < worlds.size(); ++world_id) {
-      worlds[world_id]->Evaluate();
+      if (!pipeline_epochs) worlds[world_id]->Evaluate();
       (worlds[world_id]->IsExtinct()) ? extinct_worlds.insert(world_id) : live_worlds.insert(world_id);
     }
 
     const bool all_worlds_extinct = extinct_worlds.size() == worlds.size();
 
     // Snapshot the phylogeny?
-    if (snapshot_phylogeny) {
+    if (snapshot_phylogeny && incremental_phylogeny) {
+      // Organism counts change with every birth and death in an active taxon (no systematics signal for those).
+      for (auto taxon : systematics->GetActive()) phylogeny_dirty_taxa.insert(taxon.Raw());
+      for (taxon_t* taxon : phylogeny_dirty_taxa) {
+        phylogeny_log.SetTaxonCounts(taxon->GetID(), {taxon->GetNumOrgs(), taxon->GetTotOrgs(), taxon->GetNumOff(), taxon->GetTotalOffspring()});
+      }
+      phylogeny_dirty_taxa.clear();
+      if (!phylogeny_log.WriteSnapshot(cur_epoch)) std::cout << "Failed to write phylogeny snapshot (epoch " << cur_epoch << ")." << std::endl;
+    } else if (snapshot_phylogeny) {
       systematics->Snapshot(output_dir + "phylogeny_" + emp::to_string(cur_epoch) + ".csv");
     }
 
@@ -930,18 +1210,7 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::Run() {
 
     // For each selected world, extract a sample
     propagules.resize(config.NUM_POPS(), {});
-    emp_assert(propagules.size()==selected.size());
-    for (size_t i = 0; i < selected.size(); ++i) {
-      // Sample propagules from each world!
-      size_t selected_pop_id = selected[i];
-      // Make sure selected pop is isn't extinct (in some weird edge case)
-      // Note that we cannot be here if all populations are extinct. Spin until we pull a non-extinct pop.
-      while (emp::Has(extinct_worlds, selected_pop_id)) {
-        selected_pop_id = (selected_pop_id + 1) % worlds.size();
-      }
-      // Sample from the selected world to form the propagule.
-      Sample(*worlds[selected_pop_id], propagules[i]);
-    }
+    SamplePropagules(selected);
 
     // Reset worlds + inject propagules into them!
     const size_t propagule_offset = max_world_size*worlds.size(); // Propagules will have positions offset past all valid world positions
@@ -954,27 +1223,42 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::Run() {
       for (size_t prop_i = 0; prop_i < propagules.size(); ++prop_i) {
         for (size_t gen_i = 0; gen_i < propagules[prop_i].size(); ++gen_i) {
           TransferOrg& transfer_org = propagules[prop_i][gen_i];
+          const genome_t& transfer_genome = genome_table.Get(transfer_org.genome);
+          if (transfer_org_proxy) {
+            transfer_org_proxy->GetGenome() = transfer_genome;
+          } else {
+            transfer_org_proxy = emp::NewPtr<org_t>(transfer_genome);
+          }
+          if constexpr (HasGenomeHash<org_t>::value) transfer_org_proxy->RefreshGenomeHash();
           systematics->SetNextParent(transfer_org.original_pos);
-          systematics->AddOrg(*(transfer_org.org), {propagule_offset+genome_counter, 0}, (int)transfer_time);
+          systematics->AddOrg(*transfer_org_proxy, {propagule_offset+genome_counter, 0}, (int)transfer_time);
           transfer_org.transfer_pos = propagule_offset+genome_counter;
           ++genome_counter;
         }
       }
     }
 
-    for (size_t i = 0; i < config.NUM_POPS(); ++i) {
-      auto& world = *(worlds[i]);
-      world.DirectedDevoReset(); // Clear our the world.
-      emp_assert(propagules[i].size(), "Propagule is empty.");
-      SeedWithPropagule(world, propagules[i]); // NOTE - this will handle connecting injected organisms to transfer organisms in propagule
+    if (fuse_reseed) {
+      // Pipelined epochs: each world is reset + seeded at the start of its next run job.
+      reseed_pending = true;
+      continue;
     }
 
+    if (pipeline_epochs) {
+      ForEachWorld([this](size_t world_id) { ResetAndSeedWorld(world_id); });
+    } else {
+      for (size_t i = 0; i < config.NUM_POPS(); ++i) {
+        ResetAndSeedWorld(i);
+      }
+    }
+    FlushSystematics(); // Make sure reset + seeding has reached the systematics manager before removing transfer organisms.
+
     // Now, we need to remove each of the temporary propagule organisms from the systematics tracking.
     for (size_t prop_i = 0; prop_i < propagules.size(); ++prop_i) {
       for (size_t gen_i = 0; gen_i < propagules[prop_i].size(); ++gen_i) {
         TransferOrg& transfer_org = propagules[prop_i][gen_i];
-        transfer_org.org.Delete(); // Delete transfer organism
-        transfer_org.org = nullptr;
+        genome_table.Release(transfer_org.genome); // Done with transfer genome
+        transfer_org.genome = genome_table_t::NO_HANDLE;
         if (config.TRACK_SYSTEMATICS()) systematics->RemoveOrgAfterRepro(transfer_org.transfer_pos, transfer_time);
       }
     }
@@ -984,10 +1268,16 @@ void DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::Run() {
       systematics->Update();
     }
   }
+
+  // Leave worlds in the same (freshly seeded) state they would be in without pipelining.
+  if (reseed_pending) {
+    ForEachWorld([this](size_t world_id) { ResetAndSeedWorld(world_id); });
+    reseed_pending = false;
+  }
 }
 
 template <typename WORLD, typename ORG, typename MUTATOR, typename TASK, typename PERIPHERAL>
-emp::map<typename emp::World<ORG>::genome_t, float> DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::GetWorldFitnesses(emp::map<typename emp::World<ORG>::genome_t, size_t> unique_genomes, size_t world_id, size_t remove_cell) {
+emp::map<typename emp::World<ORG>::genome_t, float> DirectedDevoExperiment<WORLD, ORG, MUTATOR, TASK, PERIPHERAL>::GetWorldFitnesses(const std::unordered_map<genome_handle_t, size_t>& unique_genomes, size_t world_id, size_t remove_cell) {
   //create world copy
   emp::Ptr<world_t> world_copy = emp::NewPtr<world_t>(
     config,
@@ -997,14 +1287,15 @@ emp::map<typename emp::World<ORG>::genome_t, float> DirectedDevoExperiment<WORLD
     random,
     #endif
     "world_"+emp::to_string(world_id),
-    world_id
+    world_id,
+    &peripheral
   );
 
   //populate world copy with only unique genomes
   //position doesn't actually matter because the world is well-mixed
   for (auto& [genome, cell] : unique_genomes) {
     if (cell != remove_cell) {
-      world_copy->InjectAt(genome, cell);
+      world_copy->InjectAt(genome_table.Get(genome), cell);
     }
   }
 
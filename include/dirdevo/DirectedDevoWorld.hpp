@@ -4,19 +4,26 @@
 
 #include <unordered_set>
 #include <deque>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 
 #include "emp/Evolve/World.hpp"
 #include "emp/datastructs/IndexMap.hpp"
 
 #include "utility/ProbabilisticScheduler.hpp"
+#include "utility/HashedGenome.hpp"
+#include "utility/hook_traits.hpp"
+#include "utility/MutationDelta.hpp"
+#include "utility/OrganismPool.hpp"
 #include "DirectedDevoConfig.hpp"
+#include "BasePeripheral.hpp"
 #include "utility/ConfigSnapshotEntry.hpp"
 #include "utility/WorldAwareDataFile.hpp"
 
 namespace dirdevo {
 
-// TODO - add world peripheral??? => Can hold instruction sets?
-//        OR, assume that directeddevoworld is not the end point? that is, you need to derive from it
+// TODO - assume that directeddevoworld is not the end point? that is, you need to derive from it
 // TODO - clean up configuration (let the world configure more of itself (move out of the experiment..)!)
 template <typename ORG, typename TASK>
 class DirectedDevoWorld : public emp::World<ORG> {
@@ -55,8 +62,22 @@ public:
   using org_t = ORG;
   using genome_t = typename base_t::genome_t;
   using config_t = DirectedDevoConfig;
-  using systematics_t = emp::Systematics<org_t, genome_t>; // TODO - work out how to add on extra taxon-associated data tracking if necessary!
+  using systematics_info_t = HashedGenome<genome_t>; ///< Taxa are keyed on genome hashes (full genomes are only compared on hash matches).
+  using systematics_t = emp::Systematics<org_t, systematics_info_t>; // TODO - work out how to add on extra taxon-associated data tracking if necessary!
   using taxon_t = typename systematics_t::taxon_t;
+  using task_hooks_t = TaskHookTraits<TASK>;   ///< Which organism-level hooks does the task implement?
+  using org_hooks_t = OrganismHookTraits<ORG>; ///< Which event hooks does the organism implement?
+
+  /// Should births, deaths, and injections call organism/task hooks directly (rather than through emp::World signals)?
+  /// Define DIRDEVO_SIGNAL_DISPATCH to route everything through signals instead.
+  /// - Either way, world signals still trigger, so external observers can attach to them.
+  /// - With direct dispatch, population changes must go through DoBirth, DoDeath, Inject, InjectAt, or DirectedDevoReset
+  ///   (other emp::World functions that add/remove organisms bypass the hooks).
+  #ifdef DIRDEVO_SIGNAL_DISPATCH
+  static constexpr bool DIRECT_DISPATCH = false;
+  #else
+  static constexpr bool DIRECT_DISPATCH = true;
+  #endif
 
   // Public functions in base type that we want to use w/out this reference
   using base_t::GetUpdate;
@@ -64,6 +85,11 @@ public:
   using base_t::GetSize;
   using base_t::GetNumOrgs;
 
+  /// Taxon info function for the systematics manager. Borrows org's genome (see HashedGenome).
+  static systematics_info_t CalcSystematicsInfo(const org_t& org) {
+    return systematics_info_t::View(org.GetGenome(), GetOrgGenomeHash(org));
+  }
+
   static bool IsValidPopStructure(const std::string & mode);
   static POP_STRUCTURE PopStructureStrToMode(const std::string & mode);
 
@@ -97,10 +123,20 @@ protected:
   using base_t::name;
   using base_t::control;
   using base_t::on_death_sig;
+  using base_t::num_orgs;
+  using base_t::before_repro_sig;
+  using base_t::offspring_ready_sig;
+  using base_t::inject_ready_sig;
+  using base_t::before_placement_sig;
+  using base_t::on_placement_sig;
+  using base_t::fun_find_birth_pos;
+  using base_t::fun_find_inject_pos;
 
   const config_t& config; ///< Reference to the experiment's configuration.
+  emp::Ptr<BasePeripheral> peripheral=nullptr; ///< Experiment-level peripheral (if any); shared by every world in the experiment.
   size_t max_pop_size=0;              /// Maximum population size (depends on population structure and configuration)
   size_t avg_org_steps_per_update=1;  /// Determines the number of execution steps we dish out each update (population size * this).
+  size_t time_slice=1;                /// Maximum number of consecutive steps an organism runs each time it is scheduled.
   bool extinct=false;                 /// flag for whether of not the population is extinct
   scheduler_t scheduler;              /// Used to schedule organism execution based on their merit.
   task_t task;                        /// Used to track task performance
@@ -109,33 +145,191 @@ protected:
   size_t world_id=0;
   size_t cur_epoch=0;
   bool track_systematics=false;
+  OrganismPool<org_t> org_pool;       /// Recycles removed organisms (direct dispatch only).
+  bool pool_orgs=true;                /// Should we recycle removed organisms?
 
   /// Wraps the shared
   // TODO - setup ability to strip out systematics tracking (because it can be a performance hit)
+  /// Births and deaths are not forwarded to the shared systematics manager as they happen. Instead, they're appended to
+  /// a compact per-world event log (positions/times already translated by offset/time_offset; genomes referenced by handle),
+  /// and taxon resolution is deferred until the log is replayed in a batch (Flush).
+  /// - If flush_on_update is set, the log is replayed every world update; otherwise, the owner (the experiment) must call Flush.
+  ///   Worlds that share a systematics manager but run on different threads must not flush on update. The experiment replays
+  ///   each world's log in world order at epoch barriers, which produces the same sequence of systematics calls as running
+  ///   worlds serially.
+  /// - Logged genomes are copy-on-write with respect to their parent's logged genome: offspring that weren't mutated
+  ///   reuse their parent's genome handle, and (for organisms that record a MutationDelta at birth) mutated offspring are
+  ///   logged as their parent's handle plus the delta. Genomes are only materialized when the log is replayed.
   struct SharedSystematicsWrapper {
+    static constexpr uint32_t NO_GENOME = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t MAX_DELTA_DEPTH = 8; ///< Longest chain of deltas before a logged genome is copied in full.
+
+    enum class EVENT_TYPE : uint8_t { SET_NEXT_PARENT, ADD_ORG, REMOVE_ORG, UPDATE };
+
+    struct Event {
+      EVENT_TYPE type;
+      uint32_t pos=0;        ///< Position in the shared systematics manager's coordinates.
+      uint32_t update=0;     ///< Update in the shared systematics manager's time.
+      uint32_t genome=0;     ///< (ADD_ORG only) Genome handle (see GenomeEntry).
+    };
+
+    /// A logged genome: either a full copy or a delta from another logged genome.
+    struct GenomeEntry {
+      uint32_t base=NO_GENOME; ///< Handle of the genome this is a delta from (NO_GENOME for full copies).
+      uint32_t index=0;        ///< Full copies: index into genomes. Deltas: first edit in delta_edits.
+      uint32_t num_edits=0;
+      uint32_t depth=0;        ///< Number of deltas between this genome and a full copy.
+      uint64_t hash=0;         ///< Genome hash (organisms that maintain their own genome hash only; see HasGenomeHash).
+    };
+
     emp::Ptr<systematics_t> sys_ptr=nullptr; ///< NON-OWNING. Pointer to the systematics manager shared by each world in an experiment.
     size_t offset=0;                 ///< world_id*GetSize()
     size_t time_offset=0;
 
+    bool flush_on_update=true;       ///< Replay the event log every world update?
+    emp::vector<Event> events;       ///< Events logged since the last Flush.
+    emp::vector<GenomeEntry> genome_entries; ///< Genomes referenced by events logged since the last Flush (indexed by handle).
+    emp::vector<genome_t> genomes;   ///< Full genome copies referenced by genome_entries.
+    emp::vector<MutationDelta::Edit> delta_edits; ///< Edits referenced by genome_entries.
+    emp::vector<uint32_t> pos_genomes; ///< Genome handle for the organism at each (local) position (NO_GENOME if not logged since last Flush).
+    uint32_t next_genome=NO_GENOME;  ///< Genome handle for the next added organism (set when an unmutated offspring is born).
+    uint32_t next_base=NO_GENOME;    ///< Parent's genome handle for the next added organism (set when a mutated offspring is born).
+    size_t next_num_muts=0;          ///< Number of mutations the next added organism has relative to next_base.
+    emp::Ptr<org_t> replay_org=nullptr; ///< Scratch organism used to hand logged genomes to the systematics manager.
+    emp::vector<uint32_t> replay_chain; ///< Scratch (see LoadReplayGenome).
+
+    /// Log org's genome: as a delta from next_base if possible, as a full copy otherwise. Returns its handle.
+    uint32_t LogGenome(org_t& org) {
+      const uint32_t handle = (uint32_t)genome_entries.size();
+      uint64_t hash = 0;
+      if constexpr (HasGenomeHash<org_t>::value) hash = org.GetGenomeHash();
+      if constexpr (HasBirthDelta<org_t>::value) {
+        const MutationDelta& delta = org.GetBirthDelta();
+        // The delta must account for every mutation (i.e., the mutator recorded it) for it to stand in for the genome.
+        if (next_base != NO_GENOME && next_num_muts == delta.size() && genome_entries[next_base].depth < MAX_DELTA_DEPTH) {
+          genome_entries.push_back({next_base, (uint32_t)delta_edits.size(), (uint32_t)delta.size(), genome_entries[next_base].depth + 1, hash});
+          delta_edits.insert(delta_edits.end(), delta.begin(), delta.end());
+          return handle;
+        }
+      }
+      genome_entries.push_back({NO_GENOME, (uint32_t)genomes.size(), 0, 0, hash});
+      genomes.emplace_back(org.GetGenome());
+      return handle;
+    }
+
+    /// Make replay_org hold the genome with the given handle, where current is the handle of the genome it holds now.
+    /// Deltas are applied on top of the nearest full copy (or of the current genome, if it's an ancestor).
+    void LoadReplayGenome(uint32_t handle, uint32_t current) {
+      if (!replay_org) {
+        replay_org = emp::NewPtr<org_t>(genomes[0]);
+        current = NO_GENOME;
+      }
+      if (handle == current) return;
+      replay_chain.clear();
+      uint32_t cur_handle = handle;
+      while (cur_handle != current && genome_entries[cur_handle].base != NO_GENOME) {
+        replay_chain.emplace_back(cur_handle);
+        cur_handle = genome_entries[cur_handle].base;
+      }
+      if (cur_handle != current) replay_org->GetGenome() = genomes[genome_entries[cur_handle].index];
+      if constexpr (HasBirthDelta<org_t>::value) {
+        for (auto it = replay_chain.rbegin(); it != replay_chain.rend(); ++it) {
+          const GenomeEntry& entry = genome_entries[*it];
+          ApplyMutationEdits(replay_org->GetGenome(), delta_edits.begin() + entry.index, delta_edits.begin() + entry.index + entry.num_edits);
+        }
+      }
+      if constexpr (HasGenomeHash<org_t>::value) replay_org->SetGenomeHash(genome_entries[handle].hash);
+    }
+
+    ~SharedSystematicsWrapper() {
+      if (replay_org) replay_org.Delete();
+    }
+
     void SetNextParent(size_t pos) {
+      SetNextParentExternal(pos + offset);
+    }
+
+    /// Set next parent using a position that is already in the shared systematics manager's coordinates
+    /// (e.g., a propagule transfer organism).
+    void SetNextParentExternal(size_t sys_pos) {
       emp_assert(sys_ptr);
-      sys_ptr->SetNextParent(pos + offset);
+      emp_assert(sys_pos < NO_GENOME);
+      events.push_back({EVENT_TYPE::SET_NEXT_PARENT, (uint32_t)sys_pos, 0, 0});
+    }
+
+    /// The next organism added is an offspring of the organism at parent_pos with num_muts mutations. Unmutated
+    /// offspring share their parent's genome handle; mutated offspring may be logged as a delta from it.
+    void InheritNextGenome(size_t parent_pos, size_t num_muts=0) {
+      const uint32_t parent_genome = (parent_pos < pos_genomes.size()) ? pos_genomes[parent_pos] : NO_GENOME;
+      next_genome = (num_muts) ? NO_GENOME : parent_genome;
+      next_base = (num_muts) ? parent_genome : NO_GENOME;
+      next_num_muts = num_muts;
     }
 
     void AddOrg(org_t& org, size_t pos, size_t update) {
       emp_assert(sys_ptr);
+      emp_assert(offset+pos < NO_GENOME);
+      uint32_t genome = next_genome;
+      if (genome == NO_GENOME) genome = LogGenome(org);
+      emp_assert(genome_entries[genome].base != NO_GENOME || genomes[genome_entries[genome].index] == org.GetGenome());
+      next_genome = NO_GENOME;
+      next_base = NO_GENOME;
+      if (pos >= pos_genomes.size()) pos_genomes.resize(pos+1, NO_GENOME);
+      pos_genomes[pos] = genome;
       // From the systematics manager's perspective, all worlds are part of pop_0 (for their WorldPosition args)
-      sys_ptr->AddOrg(org, {offset+pos, 0}, (int)(update+time_offset));
+      events.push_back({EVENT_TYPE::ADD_ORG, (uint32_t)(offset+pos), (uint32_t)(update+time_offset), genome});
     }
 
     void RemoveOrgAfterRepro(size_t pos, size_t update) {
       emp_assert(sys_ptr);
-      sys_ptr->RemoveOrgAfterRepro({offset+pos, 0}, (int)(update+time_offset));
+      if (pos < pos_genomes.size()) pos_genomes[pos] = NO_GENOME;
+      events.push_back({EVENT_TYPE::REMOVE_ORG, (uint32_t)(offset+pos), (uint32_t)(update+time_offset), 0});
+    }
+
+    /// Keep genome handles attached to their organisms when organisms swap positions.
+    void SwapOrgs(size_t pos1, size_t pos2) {
+      const size_t min_size = std::max(pos1, pos2) + 1;
+      if (pos_genomes.size() < min_size) pos_genomes.resize(min_size, NO_GENOME);
+      std::swap(pos_genomes[pos1], pos_genomes[pos2]);
     }
 
     void Update() {
       emp_assert(sys_ptr);
-      sys_ptr->Update();
+      events.push_back({EVENT_TYPE::UPDATE, 0, 0, 0});
+      if (flush_on_update) Flush();
+    }
+
+    /// Replay (in order) and clear the event log. Must not be called concurrently with other worlds' Flush calls.
+    void Flush() {
+      emp_assert(sys_ptr || !events.size());
+      uint32_t replay_genome = NO_GENOME; // Which genome does replay_org currently hold?
+      for (const Event& event : events) {
+        switch (event.type) {
+          case EVENT_TYPE::SET_NEXT_PARENT:
+            sys_ptr->SetNextParent(event.pos);
+            break;
+          case EVENT_TYPE::ADD_ORG: {
+            LoadReplayGenome(event.genome, replay_genome);
+            replay_genome = event.genome;
+            sys_ptr->AddOrg(*replay_org, {event.pos, 0}, (int)event.update);
+            break;
+          }
+          case EVENT_TYPE::REMOVE_ORG:
+            sys_ptr->RemoveOrgAfterRepro({event.pos, 0}, (int)event.update);
+            break;
+          case EVENT_TYPE::UPDATE:
+            sys_ptr->Update();
+            break;
+        }
+      }
+      events.clear();
+      genome_entries.clear();
+      genomes.clear();
+      delta_edits.clear();
+      // Genome handles are only valid until the log is flushed.
+      std::fill(pos_genomes.begin(), pos_genomes.end(), NO_GENOME);
+      next_genome = NO_GENOME;
+      next_base = NO_GENOME;
     }
 
     /// Is the shared systematics manager active?
@@ -145,6 +339,121 @@ protected:
 
   void SetPopStructure(const pop_struct_t & pop_struct); // TODO - clean this up more!
 
+  // --- World event handlers ---
+  // Tell the organism, task, scheduler, and systematics about world events. Depending on DIRECT_DISPATCH, these are either
+  // called directly (DoBirth, DoDeath, Inject, InjectAt, DirectedDevoReset) or wired up to the equivalent emp::World signals.
+
+  /// Organism is about to be injected into the population.
+  void HandleInjectReady(org_t& org) {
+    if constexpr (org_hooks_t::on_inject_ready) org.OnInjectReady();
+    if constexpr (task_hooks_t::on_org_inject_ready) task.OnOrgInjectReady(org);
+  }
+
+  /// Organism was placed at pos (just after birth or injection).
+  void HandlePlacement(size_t pos) {
+    auto& org = this->GetOrg(pos);
+    if (track_systematics) {
+      shared_systematics_wrapper.AddOrg(org, pos, GetUpdate());
+    }
+    if constexpr (org_hooks_t::on_placement) org.OnPlacement(pos);              // Tell the organism about its placement.
+    if constexpr (task_hooks_t::on_org_placement) task.OnOrgPlacement(org, pos); // Tell the task about organism placement.
+    scheduler.AdjustWeight(pos, org.GetMerit()); // Update scheduler weights last.
+    extinct=false; // World can't be extinct anymore
+  }
+
+  /// Organism at pos is about to be removed.
+  void HandleOrgDeath(size_t pos) {
+    auto& org = this->GetOrg(pos);
+    if constexpr (org_hooks_t::on_death) org.OnDeath(pos);
+    if constexpr (task_hooks_t::on_org_death) task.OnOrgDeath(org, pos);
+    scheduler.AdjustWeight(pos, 0); // Update scheduler weights last.
+    if (track_systematics) {
+      shared_systematics_wrapper.RemoveOrgAfterRepro(pos, GetUpdate());
+    }
+  }
+
+  /// Organisms at p1 and p2 were swapped.
+  void HandleSwap(emp::WorldPosition p1, emp::WorldPosition p2) {
+    auto& org1 = this->GetOrg(p1.GetIndex());
+    auto& org2 = this->GetOrg(p2.GetIndex());
+    // Organisms have already been swapped, so p1 org needs index to reflect p1; same with p2 org.
+    org1.SetWorldID(p1.GetIndex());
+    org2.SetWorldID(p2.GetIndex());
+
+    if constexpr (task_hooks_t::after_org_swap) task.AfterOrgSwap(org1, org2);
+    if (track_systematics) {
+      shared_systematics_wrapper.SwapOrgs(p1.GetIndex(), p2.GetIndex());
+    }
+
+    // Update scheduler weights last
+    const auto& weight_map = scheduler.GetWeightMap();
+    const double p1_weight = weight_map.GetWeight(p1.GetIndex());
+    const double p2_weight = weight_map.GetWeight(p2.GetIndex());
+    scheduler.AdjustWeight(p1.GetIndex(), p2_weight);
+    scheduler.AdjustWeight(p2.GetIndex(), p1_weight);
+  }
+
+  /// Organism about to reproduce. Before building offspring.
+  void HandleBeforeRepro(size_t parent_pos) {
+    if constexpr (org_hooks_t::on_before_repro || task_hooks_t::on_before_org_repro) {
+      auto& parent = this->GetOrg(parent_pos);
+      if constexpr (org_hooks_t::on_before_repro) parent.OnBeforeRepro();             // Tell parent that it's about to reproduce
+      if constexpr (task_hooks_t::on_before_org_repro) task.OnBeforeOrgRepro(parent); // Tell task about reproduction
+    }
+  }
+
+  /// Offspring constructed, but has not been placed. Last time to safely access parent.
+  void HandleOffspringReady(org_t& offspring, size_t parent_pos) {
+    const size_t num_muts = this->DoMutationsOrg(offspring); // Do mutations on offspring ready, but before parent sees offspring.
+    if (track_systematics) {
+      shared_systematics_wrapper.SetNextParent(parent_pos);
+      shared_systematics_wrapper.InheritNextGenome(parent_pos, num_muts);
+    }
+    auto& parent = this->GetOrg(parent_pos);
+    parent.SetIsParent(true);
+    if constexpr (org_hooks_t::on_birth) offspring.OnBirth(parent);                     // Tell offspring about it's birthday!
+    if constexpr (org_hooks_t::on_offspring_ready) parent.OnOffspringReady(offspring);  // Tell parent that it's offspring is ready
+    if constexpr (task_hooks_t::on_offspring_ready) task.OnOffspringReady(offspring, parent); // Tell task that this offspring was born from this parent.
+  }
+
+  /// Build a new organism (direct dispatch), reusing a pooled organism if possible.
+  emp::Ptr<org_t> NewOrg(const genome_t& mem) {
+    return pool_orgs ? org_pool.Acquire(mem) : emp::NewPtr<org_t>(mem);
+  }
+
+  /// Remove the organism at pos (direct dispatch), telling everyone about its death first.
+  /// If pooling, the organism is handed to the pool instead of being deleted.
+  /// NOTE - This mirrors emp::World::RemoveOrgAt, minus world-level systematics (this world only uses shared systematics).
+  void RemoveOrgDirect(size_t pos) {
+    emp_assert(pos < pop.size() && pop[pos]);
+    HandleOrgDeath(pos);
+    if (!pool_orgs) {
+      this->RemoveOrgAt(pos);
+      return;
+    }
+    on_death_sig.Trigger(pos);
+    org_pool.Release(pop[pos]);
+    pop[pos] = nullptr;
+    --num_orgs;
+  }
+
+  /// Place new_org at pos (direct dispatch), telling everyone about the organism it replaces (if any) and its placement.
+  /// NOTE - This mirrors emp::World::AddOrgAt (minus world-level systematics), placing the organism itself so that each signal
+  ///        triggers exactly once, in the same order as with signal dispatch: before placement, death of the replaced organism
+  ///        (if any), then placement (after the world's own placement handling).
+  void PlaceOrgDirect(emp::Ptr<org_t> new_org, emp::WorldPosition pos) {
+    emp_assert(new_org);
+    emp_assert(pos.IsActive());
+    const size_t index = pos.GetIndex();
+    before_placement_sig.Trigger(*new_org, index);
+    if (this->IsOccupied(pos)) RemoveOrgDirect(index);
+    if (index >= pop.size()) pop.resize(index+1, nullptr);
+    pop[index] = new_org;
+    ++num_orgs;
+    HandlePlacement(index);
+    on_placement_sig.Trigger(index);
+  }
+
 public:
 
   // using base_t::base_t;
@@ -152,10 +461,12 @@ public:
     const config_t& cfg,
     emp::Random & rnd,
     const std::string & name="",
-    size_t id=0
+    size_t id=0,
+    emp::Ptr<BasePeripheral> periph=nullptr
   ) :
     base_t(rnd, name),
     config(cfg),
+    peripheral(periph),
     scheduler(rnd),
     task(*this),
     pop_struct(
@@ -166,96 +477,36 @@ public:
     ),
     world_id(id)
   {
-    /// TODO - document the order of signal calls in the world!
-    /// TODO - is there a way to strip out unused functions?
-
-    // Wire up event handles to world signals.
-    // - Update scheduler weights on organism placement, death, and swap.
-    // - Tell task about placement, death, etc
-    // - Tell organism about placement, death, etc
-
-    // NOTE - reminder that on placement signal will still trigger for injected organisms!
-    this->OnInjectReady(
-      [this](org_t& org) {
-        org.OnInjectReady();
-        task.OnOrgInjectReady(org);
-      }
-    );
+    scheduler.ConfigureBatching(cfg.SCHEDULER_BATCH_SIZE(), cfg.SCHEDULER_BATCH_SORT());
+    time_slice = std::max<size_t>(1, cfg.SCHEDULER_TIME_SLICE());
+    pool_orgs = DIRECT_DISPATCH && cfg.ORGANISM_POOLING();
 
-    this->OnPlacement(
-      [this](size_t pos) {
-        auto& org = this->GetOrg(pos);
-        if (track_systematics) {
-          shared_systematics_wrapper.AddOrg(org, pos, GetUpdate());
-        }
-        org.OnPlacement(pos);                        // Tell the organism about its placement.
-        task.OnOrgPlacement(org, pos);               // Tell the task about organism placement.
-        scheduler.AdjustWeight(pos, org.GetMerit()); // Update scheduler weights last.
-        extinct=false; // World can't be extinct anymore
+    /// TODO - document the order of signal calls in the world!
+    // Hooks that the organism/task leave as their base class no-ops are stripped out at compile time (see hook_traits.hpp).
+    // With direct dispatch (the default), DoBirth/DoDeath/Inject/InjectAt call the Handle* functions directly, and the
+    // world's signals are left to external observers. Otherwise, the Handle* functions are wired up to world signals.
+    if constexpr (!DIRECT_DISPATCH) {
+      // NOTE - reminder that on placement signal will still trigger for injected organisms!
+      if constexpr (org_hooks_t::on_inject_ready || task_hooks_t::on_org_inject_ready) {
+        this->OnInjectReady([this](org_t& org) { HandleInjectReady(org); });
       }
-    );
-
-    auto org_death_key = this->OnOrgDeath(
-      [this](size_t pos) {
-        auto& org = this->GetOrg(pos);
-        org.OnDeath(pos);
-        task.OnOrgDeath(org, pos);
-        scheduler.AdjustWeight(pos, 0); // Update scheduler weights last.
-        if (track_systematics) {
-          shared_systematics_wrapper.RemoveOrgAfterRepro(pos, GetUpdate());
+      this->OnPlacement([this](size_t pos) { HandlePlacement(pos); });
+      auto org_death_key = this->OnOrgDeath([this](size_t pos) { HandleOrgDeath(pos); });
+      // We need to remove the on death signal to prevent it from being triggered when the world clears the population (calling remove org)
+      this->OnWorldDestruct(
+        [this,org_death_key]() {
+          on_death_sig.Remove(org_death_key);
         }
+      );
+      if constexpr (org_hooks_t::on_before_repro || task_hooks_t::on_before_org_repro) {
+        this->OnBeforeRepro([this](size_t parent_pos) { HandleBeforeRepro(parent_pos); });
       }
-    );
-
-    // We need to remove the on death signal to prevent it from being triggered when the world clears the population (calling remove org)
-    this->OnWorldDestruct(
-      [this,org_death_key]() {
-        on_death_sig.Remove(org_death_key);
-      }
-    );
+      this->OnOffspringReady([this](org_t& offspring, size_t parent_pos) { HandleOffspringReady(offspring, parent_pos); });
+    }
 
+    // Swaps aren't on the birth/death path, and emp::World doesn't give us another way to see them.
     this->OnSwapOrgs(
-      [this](emp::WorldPosition p1, emp::WorldPosition p2) {
-        auto& org1 = this->GetOrg(p1.GetIndex());
-        auto& org2 = this->GetOrg(p2.GetIndex());
-        // Organisms have already been swapped, so p1 org needs index to reflect p1; same with p2 org.
-        org1.SetWorldID(p1.GetIndex());
-        org2.SetWorldID(p2.GetIndex());
-
-        task.AfterOrgSwap(org1, org2);
-
-        // Update scheduler weights last
-        const auto& weight_map = scheduler.GetWeightMap();
-        const double p1_weight = weight_map.GetWeight(p1.GetIndex());
-        const double p2_weight = weight_map.GetWeight(p2.GetIndex());
-        scheduler.AdjustWeight(p1.GetIndex(), p2_weight);
-        scheduler.AdjustWeight(p2.GetIndex(), p1_weight);
-      }
-    );
-
-    // Organism about to reproduce. Before building offspring.
-    this->OnBeforeRepro(
-      [this](size_t parent_pos) {
-        auto& parent = this->GetOrg(parent_pos);
-        parent.OnBeforeRepro();     // Tell parent that it's about to reproduce
-        task.OnBeforeOrgRepro(parent); // Tell task about reproduction
-      }
-    );
-
-    // Offspring constructed, but has not been placed.
-    // Last time to safely access parent.
-    this->OnOffspringReady(
-      [this](org_t& offspring, size_t parent_pos) {
-        this->DoMutationsOrg(offspring); // Do mutations on offspring ready, but before parent sees offspring.
-        if (track_systematics) {
-          shared_systematics_wrapper.SetNextParent(parent_pos);
-        }
-        auto& parent = this->GetOrg(parent_pos);
-        parent.SetIsParent(true);
-        offspring.OnBirth(parent);                // Tell offspring about it's birthday!
-        parent.OnOffspringReady(offspring);       // Tell parent that it's offspring is ready
-        task.OnOffspringReady(offspring, parent); // Tell task that this offspring was born from this parent.
-      }
+      [this](emp::WorldPosition p1, emp::WorldPosition p2) { HandleSwap(p1, p2); }
     );
 
     // this->OnUpdate( // Removed this to guarantee it is called before
@@ -276,6 +527,22 @@ public:
 
   bool IsExtinct() const { return extinct; }
 
+  const OrganismPool<org_t>& GetOrganismPool() const { return org_pool; }
+
+  using base_t::DoDeath;
+
+  /// Reproduce the organism at parent_pos (copy_count offspring). Same event order as emp::World::DoBirth.
+  emp::WorldPosition DoBirth(const genome_t& mem, size_t parent_pos, size_t copy_count=1);
+
+  /// Remove the organism at pos.
+  void DoDeath(const emp::WorldPosition pos);
+
+  /// Inject copy_count organisms with the given genome into the population (positions chosen by the population structure).
+  void Inject(const genome_t& mem, size_t copy_count=1);
+
+  /// Inject an organism with the given genome at pos.
+  void InjectAt(const genome_t& mem, const emp::WorldPosition pos);
+
   /// Configure the average number of steps distributed to each organism per world update
   void SetAvgOrgStepsPerUpdate(size_t avg_steps);
 
@@ -288,6 +555,17 @@ public:
     std::cout << "Systematics offset ("<<world_id<<"): " << shared_systematics_wrapper.offset << std::endl;
   }
 
+  /// Should logged systematics events be replayed every update? If not, the owner must call FlushSharedSystematics.
+  /// Must be disabled if worlds sharing a systematics manager run on different threads.
+  void SetSharedSystematicsFlushOnUpdate(bool flush) {
+    shared_systematics_wrapper.flush_on_update = flush;
+  }
+
+  /// Replay any logged systematics events on the shared systematics manager.
+  void FlushSharedSystematics() {
+    if (track_systematics) shared_systematics_wrapper.Flush();
+  }
+
   void SetEpoch(size_t epoch) {
     cur_epoch = epoch;
     shared_systematics_wrapper.time_offset = epoch * config.UPDATES_PER_EPOCH();
@@ -335,6 +613,10 @@ public:
 
   const config_t& GetConfig() const { return config; }
 
+  /// Experiment-level peripheral handed to this world at construction (nullptr if the world was built without one).
+  /// Tasks can use it to share read-only resources across worlds (see OnWorldSetup).
+  emp::Ptr<BasePeripheral> GetPeripheral() const { return peripheral; }
+
 };
 
 template<typename ORG, typename TASK>
@@ -403,16 +685,26 @@ void DirectedDevoWorld<ORG,TASK>::RunStep() {
 
   // --- Beyond this point: assume that the scheduler weights are current and up-to-date ---
   // Compute how many organism steps we can dish out for this world update!
+  // Each scheduled organism runs for a time slice of up to time_slice steps. Organisms are scheduled in proportion to merit,
+  // so slices are too; steps (not slices) count against the budget, so the expected number of steps per update doesn't change.
   const size_t org_step_budget = num_orgs*avg_org_steps_per_update;
-  for (size_t step = 0; step < org_step_budget; ++step) {
+  for (size_t step = 0; step < org_step_budget; ) {
     // Schedule someone to take a step.
     emp_assert(scheduler.GetWeightMap().GetWeight() > 0, step, this->GetNumOrgs());
-    const size_t org_id = scheduler.GetRandom(); // This should reweight the scheduler automatically.
+    const size_t org_id = scheduler.GetNext(); // This should reweight the scheduler automatically.
     auto & org = this->GetOrg(org_id);
-    // Step organism forward
-    task.BeforeOrgProcessStep(org);
-    org.ProcessStep(*this);
-    task.AfterOrgProcessStep(org);
+    // Step organism forward (task hooks run once per slice; end the slice early if the organism is ready to reproduce or dies)
+    // Slices never run past a task-imposed lifetime, so AfterOrgProcessStep still sees the step that ends it.
+    size_t slice = std::min(time_slice, org_step_budget - step);
+    if constexpr (task_hooks_t::org_steps_remaining) slice = std::max<size_t>(1, std::min(slice, task.GetOrgStepsRemaining(org)));
+    if constexpr (task_hooks_t::before_org_process_step) task.BeforeOrgProcessStep(org);
+    size_t slice_steps = 0;
+    do {
+      org.ProcessStep(*this);
+      ++slice_steps;
+    } while (slice_steps < slice && !org.GetReproReady() && !org.GetDead());
+    step += slice_steps;
+    if constexpr (task_hooks_t::after_org_process_step) task.AfterOrgProcessStep(org);
     // Should organism reproduce?
     if (org.GetReproReady()) {
       auto offspring_pos = this->DoBirth(org.GetGenome(), org_id, 1);
@@ -500,6 +792,71 @@ std::map<typename emp::World<ORG>::genome_t, float> DirectedDevoWorld<ORG,TASK>:
   return genome_fitnesses;
 }
 
+template<typename ORG, typename TASK>
+emp::WorldPosition DirectedDevoWorld<ORG,TASK>::DoBirth(const genome_t& mem, size_t parent_pos, size_t copy_count) {
+  if constexpr (!DIRECT_DISPATCH) return base_t::DoBirth(mem, parent_pos, copy_count);
+  HandleBeforeRepro(parent_pos);
+  before_repro_sig.Trigger(parent_pos);
+  emp::WorldPosition pos;
+  for (size_t i = 0; i < copy_count; ++i) {
+    emp::Ptr<org_t> new_org = NewOrg(mem);
+    HandleOffspringReady(*new_org, parent_pos);
+    offspring_ready_sig.Trigger(*new_org, parent_pos);
+    pos = fun_find_birth_pos(new_org, parent_pos);
+    if (pos.IsValid()) {
+      PlaceOrgDirect(new_org, pos);
+    } else if (pool_orgs) {
+      org_pool.Release(new_org);
+    } else {
+      new_org.Delete();
+    }
+  }
+  return pos;
+}
+
+template<typename ORG, typename TASK>
+void DirectedDevoWorld<ORG,TASK>::DoDeath(const emp::WorldPosition pos) {
+  if constexpr (DIRECT_DISPATCH) {
+    if (this->IsOccupied(pos)) RemoveOrgDirect(pos.GetIndex());
+    return;
+  }
+  base_t::DoDeath(pos);
+}
+
+template<typename ORG, typename TASK>
+void DirectedDevoWorld<ORG,TASK>::Inject(const genome_t& mem, size_t copy_count) {
+  if constexpr (!DIRECT_DISPATCH) {
+    base_t::Inject(mem, copy_count);
+    return;
+  }
+  for (size_t i = 0; i < copy_count; ++i) {
+    emp::Ptr<org_t> new_org = NewOrg(mem);
+    HandleInjectReady(*new_org);
+    inject_ready_sig.Trigger(*new_org);
+    const emp::WorldPosition pos = fun_find_inject_pos(new_org);
+    if (pos.IsValid()) {
+      PlaceOrgDirect(new_org, pos);
+    } else if (pool_orgs) {
+      org_pool.Release(new_org);
+    } else {
+      new_org.Delete();
+    }
+  }
+}
+
+template<typename ORG, typename TASK>
+void DirectedDevoWorld<ORG,TASK>::InjectAt(const genome_t& mem, const emp::WorldPosition pos) {
+  if constexpr (!DIRECT_DISPATCH) {
+    base_t::InjectAt(mem, pos);
+    return;
+  }
+  emp_assert(pos.IsValid());
+  emp::Ptr<org_t> new_org = NewOrg(mem);
+  HandleInjectReady(*new_org);
+  inject_ready_sig.Trigger(*new_org);
+  PlaceOrgDirect(new_org, pos);
+}
+
 template<typename ORG, typename TASK>
 void DirectedDevoWorld<ORG,TASK>::Evaluate() {
   task.Evaluate();
@@ -508,6 +865,12 @@ void DirectedDevoWorld<ORG,TASK>::Evaluate() {
 template<typename ORG, typename TASK>
 void DirectedDevoWorld<ORG,TASK>::DirectedDevoReset() {
   task.OnWorldReset();          // Tell task that the world is being reset.
+  if constexpr (DIRECT_DISPATCH) {
+    // Base reset would clear the population without going through our death handler (or the organism pool).
+    for (size_t pos = 0; pos < pop.size(); ++pos) {
+      if (pop[pos]) RemoveOrgDirect(pos);
+    }
+  }
   base_t::Reset();              // Call base reset function.
   SetPopStructure(pop_struct);  // Reset the population structure.
 }
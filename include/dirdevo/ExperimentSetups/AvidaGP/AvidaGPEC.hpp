@@ -28,6 +28,8 @@
 #include "emp/Evolve/World.hpp"
 #include "emp/config/config.hpp"
 #include "emp/control/Signal.hpp"
+#include "emp/datastructs/map_utils.hpp"
+#include "emp/datastructs/set_utils.hpp"
 
 // local includes
 #include "AvidaGPOrganism.hpp"
@@ -66,6 +68,7 @@ EMP_BUILD_CONFIG(AvidaGPEvoCompConfig,
   GROUP(AVIDAGP_MUTATION_SETTINGS, "Settings specific to AvidaGP mutation"),
   VALUE(AVIDAGP_MUT_RATE_INST_SUB, double, 0.01, "Instruction substitution rate (applied per-instruction)"),
   VALUE(AVIDAGP_MUT_RATE_ARG_SUB, double, 0.025, "Instruction argument substitution rate (applied per-argument)"),
+  VALUE(MUTATION_SAMPLING, std::string, "per-site", "How does the mutator pick sites to mutate? Options: per-site (one random draw per site; the original behavior), skip (draw the gap to the next mutated site from a geometric distribution; same per-site distribution, far fewer draws at low rates)"),
 
   GROUP(AVIDAGP_ENV_SETTINGS, "Settings specific to AvidaGP environment/task"),
   VALUE(AVIDAGP_UNIQUE_ENV_OUTPUT, bool, true, "Should each environment input buffer result in unique output for all environment tasks?"),
@@ -207,6 +210,7 @@ protected:
   const config_t& config;
 
   inst_lib_t inst_lib;
+  hardware_t::OpcodeTable opcode_table; ///< Decodes inst_lib for organism hardware (see SetupInstLib)
   mutator_t mutator;
 
   bool found_solution;
@@ -350,9 +354,9 @@ void AvidaGPEvoCompWorld::Setup() {
         auto& pathway = task_pathways[pathway_id];
         auto& env_bank = *(pathway.env_bank);
         const size_t env_id = random_ptr->GetUInt(env_bank.GetSize());
-        org.GetHardware().SetEnvID(pathway_id, env_id);
-        org.GetHardware().GetInputBuffer(pathway_id) = env_bank.GetEnvironment(env_id).input_buffer;
+        org.GetHardware().BindEnvironment(pathway_id, env_id, env_bank.GetEnvironment(env_id).GetInputBuffer());
       }
+      org.GetHardware().SetOpcodeTable(&opcode_table);
     }
   );
 
@@ -668,9 +672,7 @@ void AvidaGPEvoCompWorld::SetupInstLib() {
  // Add instruction: Nop
   inst_lib.AddInst(
     "Nop",
-    [](hardware_t& hw, const hardware_t::inst_t& inst) {
-      return;
-    },
+    hardware_t::Inst_Nop,
     0,
     "No operation"
   );
@@ -678,9 +680,7 @@ void AvidaGPEvoCompWorld::SetupInstLib() {
   // Add instruction: GetLen
   inst_lib.AddInst(
     "GetLen",
-    [](hardware_t& hw, const hardware_t::inst_t& inst) {
-      hw.regs[inst.args[0]] = hw.GetSize();
-    },
+    hardware_t::Inst_GetLen,
     1,
     "REG[ARG0]=ProgramSize"
   );
@@ -688,9 +688,7 @@ void AvidaGPEvoCompWorld::SetupInstLib() {
   // Add nand instruction
   inst_lib.AddInst(
     "Nand",
-    [](hardware_t& hw, const hardware_t::inst_t& inst) {
-      hw.regs[inst.args[2]] = ~((uint32_t)hw.regs[inst.args[0]]&(uint32_t)hw.regs[inst.args[1]]);
-    },
+    hardware_t::Inst_Nand,
     3,
     "REG[ARG3]=~(REG[ARG1]&REG[ARG2])"
   );
@@ -701,12 +699,7 @@ void AvidaGPEvoCompWorld::SetupInstLib() {
     inst_lib.AddInst(
       emp::to_string("Input-", pathway_id),
       [pathway_id](hardware_t& hw, const hardware_t::inst_t& inst) {
-        const auto& input_buffer = hw.GetInputBuffer(pathway_id);
-        emp_assert(input_buffer.size(), "Input buffer should contain at least one element", pathway_id, input_buffer.size());
-        const size_t input_ptr = hw.AdvanceInputPointer(pathway_id);    // Returns the current input pointer value and then advances the pointer.
-        emp_assert(input_ptr < input_buffer.size(), input_ptr, input_buffer.size());
-        const auto input_val = input_buffer[input_ptr];
-        hw.regs[inst.args[0]] = input_val;
+        hardware_t::Inst_Input(hw, inst, pathway_id);
       },
       1,
       "REG[ARG0]=NextInput"
@@ -716,20 +709,22 @@ void AvidaGPEvoCompWorld::SetupInstLib() {
     inst_lib.AddInst(
       emp::to_string("Output-", pathway_id),
       [pathway_id](hardware_t& hw, const hardware_t::inst_t& inst) {
-        hw.GetOutputBuffer(pathway_id).emplace_back(hw.regs[inst.args[0]]);
+        hardware_t::Inst_Output(hw, inst, pathway_id);
       },
       1,
       "Push REG[ARG0] to output buffer"
     );
   }
 
+  // Decode instructions by name for the hardware's pre-decoded interpreter.
+  opcode_table.Build(inst_lib);
 }
 
 void AvidaGPEvoCompWorld::SetupMutator() {
   mutator_t::Configure(mutator, config);
   SetMutFun(
     [this](org_t& org, emp::Random& rnd) {
-      const size_t mut_cnt = mutator.Mutate(org.GetGenome(), *random_ptr);
+      const size_t mut_cnt = MutateOrganism(mutator, org, *random_ptr);
       return mut_cnt;
     }
   );
@@ -915,12 +910,12 @@ void AvidaGPEvoCompWorld::DoEvaluation() {
     for (size_t pathway_id = 0; pathway_id < num_pathways; ++pathway_id) {
       auto& output_buffer = org.GetHardware().GetOutputBuffer(pathway_id);
       auto& pathway = task_pathways[pathway_id];
-      const auto& env = pathway.env_bank->GetEnvironment(org.GetHardware().GetEnvID(pathway_id));
+      const auto env = pathway.env_bank->GetEnvironment(org.GetHardware().GetEnvID(pathway_id));
       for (auto value : output_buffer) {
         // Is this value the correct output to any tasks?
-        if (emp::Has(env.valid_outputs, value)) {
-          emp_assert(env.task_lookup.find(value)->second.size() == 1, "Environment should guarantee unique output for each operation");
-          const size_t local_task_id = env.task_lookup.find(value)->second[0];
+        const size_t local_task_id = env.GetTaskID(value);
+        if (local_task_id != env_bank_t::NO_TASK) {
+          emp_assert(env.CountTasks(value) == 1, "Environment should guarantee unique output for each operation");
           const size_t global_task_id = pathway.global_task_id_lookup[local_task_id];
           // IF REPEATABLE: Increase world level task performance no matter what.
           // IF NOT REPEATABLE: If this is the first time an organism is performing this task, increase population-level task performance counter.
@@ -1,23 +1,40 @@
 #pragma once
 
-#include <unordered_set>
-#include <unordered_map>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <type_traits>
 #include <utility>
 
+#ifdef DIRDEVO_THREADING
+#include <atomic>
+#include <thread>
+#endif // DIRDEVO_THREADING
+
 #include "emp/base/assert_warning.hpp"
 #include "emp/base/vector.hpp"
 #include "emp/math/Random.hpp"
-#include "emp/datastructs/map_utils.hpp"
-#include "emp/datastructs/set_utils.hpp"
 #include "emp/base/Ptr.hpp"
 
+#include "../../utility/InlineBuffer.hpp"
+#include "../../utility/MappedFile.hpp"
 #include "AvidaGPTaskSet.hpp"
 
 /// Precompute l9 environments to be used during an experiment
 namespace dirdevo {
 
 /// Bank of L9 instances
-/// TODO - save and load functionality
+/// Environments are stored contiguously (structure-of-arrays) for the whole bank rather than as individual node-based
+/// containers: each environment gets ENV_NUM_INPUTS inputs, its correct output for each task (indexed by task id), and
+/// its correct outputs sorted by value alongside their task ids (so output lookups are a search over a few adjacent values).
+/// Banks can be saved to (SaveBank) and memory-mapped back from (LoadBank) a binary bank file; see BankFileHeader for
+/// the file layout. Bank files are identified by a key (GetBankKey) computed from the task set, bank size, output
+/// uniqueness, and generation seed.
 class AvidaGPEnvironmentBank {
 public:
 
@@ -25,34 +42,89 @@ public:
   using task_set_t = AvidaGPTaskSet;
   using input_t = typename task_set_t::input_t;
   using output_t = typename task_set_t::output_t;
+  using task_id_t = uint16_t;
 
   static constexpr input_t MIN_LOGIC_TASK_INPUT=0;
   static constexpr input_t MAX_LOGIC_TASK_INPUT=100000000; // max uint32: 4294967295
   static constexpr size_t MAX_ENV_BUILD_TRIES=10000;
+  static constexpr size_t ENV_NUM_INPUTS=2;
+  static constexpr size_t NO_TASK=(size_t)-1;
+  static constexpr size_t GENERATION_CHUNK_SIZE=1024; ///< Environments per generation chunk (changing this changes generated banks!)
+
+  static constexpr uint32_t BANK_FILE_VERSION=3; ///< 2: banks generated in chunks; 3: batched chunk generation (see BuildChunk)
+  static constexpr uint32_t BANK_FILE_BYTE_ORDER=0x01020304;
+  static constexpr char BANK_FILE_MAGIC[8]={'D','D','E','V','B','N','K','\0'};
+
+  /// Bank file header. A bank file is this header followed by the task names (each '\0'-terminated), then each of the
+  /// bank's arrays (inputs, correct outputs, sorted outputs, sorted task ids, collision flags) at the given byte offsets.
+  /// Offsets are multiples of 8, so arrays are aligned when the file is mapped. Files are written in native byte order
+  /// (byte_order lets us reject files written on a machine with different endianness).
+  struct BankFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t key;
+    int64_t seed;
+    uint64_t num_envs;
+    uint64_t num_tasks;
+    uint64_t num_inputs;
+    uint64_t unique_outputs;
+    uint64_t value_size;
+    uint64_t task_names_offset;
+    uint64_t task_names_size;
+    uint64_t inputs_offset;
+    uint64_t correct_outputs_offset;
+    uint64_t sorted_outputs_offset;
+    uint64_t sorted_task_ids_offset;
+    uint64_t collisions_offset;
+    uint64_t file_size;
+  };
+  static_assert(std::is_trivially_copyable<BankFileHeader>::value && sizeof(BankFileHeader) % 8 == 0);
 
   /// Numeric environment (specifies input buffer for an organism + all correct outputs)
-  struct Environment {
-    emp::vector<input_t> input_buffer;                ///< Species the inputs for this environment instance.
-    std::unordered_set<output_t> valid_outputs;       ///< Set of valid output values for this environment.
-    emp::vector<output_t> correct_outputs;            ///< Correct outputs indexed by task id.
-    std::unordered_map<output_t, emp::vector<size_t>> task_lookup; ///< Which output belongs to which task?
-    bool is_collision=false;
-
-    /// clear the environment
-    void Clear() {
-      input_buffer.clear();
-      valid_outputs.clear();
-      correct_outputs.clear();
-      task_lookup.clear();
-      is_collision=false;
-    }
-
-    bool operator==(const Environment& other) const {
-      return std::tie(
-        input_buffer, valid_outputs, correct_outputs, task_lookup
-      ) == std::tie(
-        other.input_buffer, other.valid_outputs, other.correct_outputs, other.task_lookup
-      );
+  /// Lightweight, read-only view of an environment stored in the bank (cheap to copy; valid until the bank is regenerated/cleared).
+  class Environment {
+  protected:
+    const this_t* bank=nullptr;
+    size_t env_id=0;
+
+    const output_t* SortedBegin() const { return bank->sorted_output_data + env_id*bank->num_tasks; }
+    const output_t* SortedEnd() const { return SortedBegin() + bank->num_tasks; }
+
+  public:
+    Environment(const this_t& b, size_t id) : bank(&b), env_id(id) { ; }
+
+    size_t GetID() const { return env_id; }
+    size_t GetNumTasks() const { return bank->num_tasks; }
+    bool IsCollision() const { return bank->collision_data[env_id]; }
+
+    /// Species the inputs for this environment instance.
+    BufferView<input_t> GetInputBuffer() const {
+      return {bank->input_data + env_id*ENV_NUM_INPUTS, ENV_NUM_INPUTS};
+    }
+
+    /// Correct output for the given task.
+    output_t GetCorrectOutput(size_t task_id) const {
+      emp_assert(task_id < bank->num_tasks, task_id, bank->num_tasks);
+      return bank->correct_output_data[env_id*bank->num_tasks + task_id];
+    }
+
+    /// Which task is value the correct output for? Returns NO_TASK if value isn't a correct output for any task.
+    /// (If multiple tasks share an output, returns the one with the lowest id.)
+    size_t GetTaskID(output_t value) const {
+      const output_t* begin = SortedBegin();
+      const output_t* it = std::lower_bound(begin, SortedEnd(), value);
+      if (it == SortedEnd() || *it != value) return NO_TASK;
+      return bank->sorted_task_id_data[env_id*bank->num_tasks + (size_t)(it - begin)];
+    }
+
+    /// Is value the correct output for any task?
+    bool IsValidOutput(output_t value) const { return std::binary_search(SortedBegin(), SortedEnd(), value); }
+
+    /// How many tasks is value the correct output for?
+    size_t CountTasks(output_t value) const {
+      const auto range = std::equal_range(SortedBegin(), SortedEnd(), value);
+      return (size_t)(range.second - range.first);
     }
 
   };
@@ -61,46 +133,133 @@ protected:
 
   emp::Random& random;
   task_set_t& task_set;
-  emp::vector<emp::Ptr<Environment>> environment_bank; ///< Bank of environments.
-
-  /// Internal helper function to add a task (task_id) output (output_value) to an environment (env)
-  void SetEnvOutput(Environment& env, size_t task_id, output_t output_value) {
-    if (task_id >= env.correct_outputs.size()) { env.correct_outputs.resize(task_id+1, 0); }
-    env.correct_outputs[task_id] = output_value; // Set correct output for this task id.
-    env.is_collision = emp::Has(env.valid_outputs, output_value); // Mark if environment contains an output collision.
-    env.valid_outputs.emplace(output_value); // Add output value to valid outputs set.
-    // Add output value to task lookup (regardless of whether or not we've seen this output value before)
-    if (emp::Has(env.task_lookup, output_value)) {
-      env.task_lookup.find(output_value)->second.emplace_back(task_id);
-    } else {
-      env.task_lookup.emplace(
-        std::make_pair(output_value, emp::vector<size_t>({task_id}))
-      );
+
+  size_t num_envs=0;
+  size_t num_tasks=0;                      ///< Number of tasks (fixed when the bank is generated).
+  emp::vector<input_t> inputs;             ///< ENV_NUM_INPUTS inputs per environment.
+  emp::vector<output_t> correct_outputs;   ///< num_tasks correct outputs per environment, indexed by task id.
+  emp::vector<output_t> sorted_outputs;    ///< num_tasks correct outputs per environment, sorted by value.
+  emp::vector<task_id_t> sorted_task_ids;  ///< Task id of each value in sorted_outputs.
+  emp::vector<uint8_t> collisions;         ///< Does the environment have an output collision (two tasks with the same output)?
+
+  // Environment views read through these, which point either into the vectors above (generated banks) or into a
+  // mapped bank file (loaded banks).
+  const input_t* input_data=nullptr;
+  const output_t* correct_output_data=nullptr;
+  const output_t* sorted_output_data=nullptr;
+  const task_id_t* sorted_task_id_data=nullptr;
+  const uint8_t* collision_data=nullptr;
+  emp::Ptr<MappedFile> mapped_file=nullptr; ///< Set if this bank was loaded from a bank file.
+
+  double generation_time=0;   ///< How long (in seconds) did the last GenerateBank take?
+  size_t generation_threads=1; ///< How many threads did the last GenerateBank use?
+
+  void UseOwnedStorage() {
+    input_data = inputs.data();
+    correct_output_data = correct_outputs.data();
+    sorted_output_data = sorted_outputs.data();
+    sorted_task_id_data = sorted_task_ids.data();
+    collision_data = collisions.data();
+  }
+
+  emp::vector<std::string> GetTaskNames() const {
+    emp::vector<std::string> names(task_set.GetSize());
+    for (size_t i = 0; i < names.size(); ++i) names[i] = task_set.GetName(i);
+    return names;
+  }
+
+  static uint64_t AlignFileOffset(uint64_t offset) { return (offset + 7) & ~(uint64_t)7; }
+
+  /// Scratch space for building environments (one per generation chunk, so chunks can be built concurrently).
+  struct BuildScratch {
+    emp::vector<input_t> input_a;       ///< First input of each environment in the chunk.
+    emp::vector<input_t> input_b;       ///< Second input of each environment in the chunk.
+    emp::vector<output_t> task_outputs; ///< Outputs by task (task_id*chunk size + environment offset).
+    emp::vector<output_t> env_outputs;  ///< One environment's outputs (indexed by task id).
+    emp::vector<std::pair<output_t, task_id_t>> sorted;
+  };
+
+  /// Record environment env_id's inputs and outputs (env_outputs is indexed by task id). Returns whether any two tasks
+  /// share an output.
+  bool StoreEnvironment(size_t env_id, input_t a, input_t b, const output_t* env_outputs, BuildScratch& scratch) {
+    auto& sorted = scratch.sorted;
+    sorted.resize(num_tasks);
+    for (size_t task_id = 0; task_id < num_tasks; ++task_id) {
+      correct_outputs[env_id*num_tasks + task_id] = env_outputs[task_id];
+      sorted[task_id] = {env_outputs[task_id], (task_id_t)task_id};
     }
+    std::sort(sorted.begin(), sorted.end());
+    const bool is_collision = std::adjacent_find(
+      sorted.begin(),
+      sorted.end(),
+      [](const auto& x, const auto& y) { return x.first == y.first; }
+    ) != sorted.end();
+    inputs[env_id*ENV_NUM_INPUTS] = a;
+    inputs[env_id*ENV_NUM_INPUTS + 1] = b;
+    for (size_t i = 0; i < num_tasks; ++i) {
+      sorted_outputs[env_id*num_tasks + i] = sorted[i].first;
+      sorted_task_ids[env_id*num_tasks + i] = sorted[i].second;
+    }
+    collisions[env_id] = is_collision;
+    return is_collision;
   }
 
-  Environment BuildEnvironment(bool unique_outputs) {
-    Environment env;
-    env.is_collision=true;
-    size_t build_tries = 0;
-    do {
-      env.Clear();
-      env.correct_outputs.resize(task_set.GetSize(), (uint32_t)-1);
-      env.input_buffer = {
-        (input_t)random.GetUInt(this_t::MIN_LOGIC_TASK_INPUT, this_t::MAX_LOGIC_TASK_INPUT),
-        (input_t)random.GetUInt(this_t::MIN_LOGIC_TASK_INPUT, this_t::MAX_LOGIC_TASK_INPUT)
-      };
-      for (size_t task_id = 0; (task_id < task_set.GetSize()) && !env.is_collision; ++task_id) {
-        const auto& task = task_set.GetTask(task_id);
-        const output_t task_output = task.calc_output_fun(
-          (task.num_inputs > 1) ? env.input_buffer : emp::vector<input_t>({env.input_buffer[0]})
-        );
-        SetEnvOutput(env, task_id, task_output);
+  /// Redraw environment env_id's inputs until each task has a unique output (or we run out of tries).
+  void RebuildEnvironment(size_t env_id, emp::Random& rng, BuildScratch& scratch) {
+    auto& env_outputs = scratch.env_outputs;
+    env_outputs.resize(num_tasks);
+    bool is_collision=true;
+    size_t build_tries = 1; // The environment's first build counts.
+    while (is_collision && (build_tries < this_t::MAX_ENV_BUILD_TRIES)) {
+      const input_t a = (input_t)rng.GetUInt(this_t::MIN_LOGIC_TASK_INPUT, this_t::MAX_LOGIC_TASK_INPUT);
+      const input_t b = (input_t)rng.GetUInt(this_t::MIN_LOGIC_TASK_INPUT, this_t::MAX_LOGIC_TASK_INPUT);
+      const input_t* env_inputs[ENV_NUM_INPUTS] = {&a, &b};
+      for (size_t task_id = 0; task_id < num_tasks; ++task_id) {
+        task_set.CalcOutputs(task_id, env_inputs, env_outputs.data() + task_id, 1);
       }
+      is_collision = StoreEnvironment(env_id, a, b, env_outputs.data(), scratch);
       ++build_tries;
-    } while (env.is_collision && unique_outputs && (build_tries < this_t::MAX_ENV_BUILD_TRIES));
-    emp_assert_warning(build_tries <= this_t::MAX_ENV_BUILD_TRIES, "Failed to build environment with unique outputs for each task.");
-    return env;
+    }
+    emp_assert_warning(!is_collision, "Failed to build environment with unique outputs for each task.");
+  }
+
+  /// Seed for a generation chunk's random number generator (a splitmix64 mix of the bank's base seed and the chunk id).
+  static int GetChunkSeed(uint64_t base_seed, size_t chunk_id) {
+    uint64_t z = base_seed + 0x9e3779b97f4a7c15ull * (chunk_id + 1);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    z = z ^ (z >> 31);
+    return (int)(z % 2147483646) + 1; // emp::Random treats non-positive seeds as 'seed from time'
+  }
+
+  /// Build every environment in chunk chunk_id.
+  /// Every environment's inputs are drawn up front and each task's outputs are computed for the whole chunk at once
+  /// (with the task set's batch functions). Environments with colliding outputs are then redrawn one at a time (in
+  /// order) if unique_outputs is set.
+  void BuildChunk(size_t chunk_id, uint64_t base_seed, bool unique_outputs) {
+    emp::Random rng(GetChunkSeed(base_seed, chunk_id));
+    BuildScratch scratch;
+    const size_t chunk_begin = chunk_id * GENERATION_CHUNK_SIZE;
+    const size_t chunk_size = std::min(num_envs, chunk_begin + GENERATION_CHUNK_SIZE) - chunk_begin;
+    scratch.input_a.resize(chunk_size);
+    scratch.input_b.resize(chunk_size);
+    scratch.task_outputs.resize(chunk_size*num_tasks);
+    scratch.env_outputs.resize(num_tasks);
+    for (size_t i = 0; i < chunk_size; ++i) {
+      scratch.input_a[i] = (input_t)rng.GetUInt(this_t::MIN_LOGIC_TASK_INPUT, this_t::MAX_LOGIC_TASK_INPUT);
+      scratch.input_b[i] = (input_t)rng.GetUInt(this_t::MIN_LOGIC_TASK_INPUT, this_t::MAX_LOGIC_TASK_INPUT);
+    }
+    const input_t* chunk_inputs[ENV_NUM_INPUTS] = {scratch.input_a.data(), scratch.input_b.data()};
+    for (size_t task_id = 0; task_id < num_tasks; ++task_id) {
+      task_set.CalcOutputs(task_id, chunk_inputs, scratch.task_outputs.data() + task_id*chunk_size, chunk_size);
+    }
+    for (size_t i = 0; i < chunk_size; ++i) {
+      for (size_t task_id = 0; task_id < num_tasks; ++task_id) {
+        scratch.env_outputs[task_id] = scratch.task_outputs[task_id*chunk_size + i];
+      }
+      const bool is_collision = StoreEnvironment(chunk_begin + i, scratch.input_a[i], scratch.input_b[i], scratch.env_outputs.data(), scratch);
+      if (is_collision && unique_outputs) RebuildEnvironment(chunk_begin + i, rng, scratch);
+    }
   }
 
 public:
@@ -113,37 +272,243 @@ public:
     task_set(a_task_set)
   { ; }
 
+  AvidaGPEnvironmentBank(const AvidaGPEnvironmentBank&) = delete;
+  AvidaGPEnvironmentBank& operator=(const AvidaGPEnvironmentBank&) = delete;
+
   ~AvidaGPEnvironmentBank() {
     Clear();
   }
 
   /// Generate count number of task environment instances, adding each to the environment bank.
   /// Each environment is guaranteed to have unique outputs for teach possible task.
+  /// Environments are built in fixed-size chunks, each with its own random number generator (seeded from one draw from
+  /// the bank's generator and the chunk id), so the resulting bank is the same no matter how many threads build it.
+  /// num_threads=0 uses all hardware threads. (Threads are only used when compiled with DIRDEVO_THREADING.)
   /// WARNING - calling this function will delete any existing environments in this bank, invalidating references to them.
-  void GenerateBank(size_t count, bool unique_outputs=true) {
+  void GenerateBank(size_t count, bool unique_outputs=true, size_t num_threads=1) {
+    const auto start_time = std::chrono::steady_clock::now();
     Clear();
-    environment_bank.resize(count, nullptr);
-    for (size_t n = 0; n < count; n++) {
-      environment_bank[n] = emp::NewPtr<Environment>(BuildEnvironment(unique_outputs));
+    num_tasks = task_set.GetSize();
+    emp_assert(num_tasks <= std::numeric_limits<task_id_t>::max(), num_tasks);
+    num_envs = count;
+    inputs.resize(count*ENV_NUM_INPUTS);
+    correct_outputs.resize(count*num_tasks);
+    sorted_outputs.resize(count*num_tasks);
+    sorted_task_ids.resize(count*num_tasks);
+    collisions.resize(count);
+
+    const uint64_t base_seed = random.GetUInt64();
+    const size_t num_chunks = (count + GENERATION_CHUNK_SIZE - 1) / GENERATION_CHUNK_SIZE;
+    generation_threads = 1;
+    #ifdef DIRDEVO_THREADING
+    if (num_threads == 0) num_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    generation_threads = std::max<size_t>(1, std::min(num_threads, num_chunks));
+    if (generation_threads > 1) {
+      std::atomic<size_t> next_chunk(0);
+      emp::vector<std::thread> workers;
+      for (size_t i = 0; i < generation_threads; ++i) {
+        workers.emplace_back([this, &next_chunk, num_chunks, base_seed, unique_outputs]() {
+          for (size_t chunk_id = next_chunk++; chunk_id < num_chunks; chunk_id = next_chunk++) {
+            BuildChunk(chunk_id, base_seed, unique_outputs);
+          }
+        });
+      }
+      for (auto& worker : workers) worker.join();
+    } else
+    #endif // DIRDEVO_THREADING
+    {
+      for (size_t chunk_id = 0; chunk_id < num_chunks; ++chunk_id) {
+        BuildChunk(chunk_id, base_seed, unique_outputs);
+      }
     }
+    UseOwnedStorage();
+    generation_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
   }
 
   void Clear() {
-    for (emp::Ptr<Environment> env : environment_bank) {
-      env.Delete();
+    num_envs=0;
+    num_tasks=0;
+    inputs.clear();
+    correct_outputs.clear();
+    sorted_outputs.clear();
+    sorted_task_ids.clear();
+    collisions.clear();
+    UseOwnedStorage();
+    generation_time=0;
+    generation_threads=1;
+    if (mapped_file) mapped_file.Delete();
+    mapped_file = nullptr;
+  }
+
+  bool IsMapped() const { return (bool)mapped_file; }
+
+  /// Generation throughput of the last GenerateBank (environments per second).
+  double GetGenerationThroughput() const { return (generation_time > 0) ? num_envs / generation_time : 0; }
+  double GetGenerationTime() const { return generation_time; }
+  size_t GetGenerationThreads() const { return generation_threads; }
+
+  /// Key that identifies a bank file: a hash (64-bit FNV-1a) of the file format version, the task set (task names in
+  /// task id order), the bank size, whether outputs are unique, and the seed used to generate the bank.
+  static uint64_t GetBankKey(const task_set_t& tasks, size_t size, bool unique_outputs, int64_t seed) {
+    uint64_t hash = 14695981039346656037ull;
+    auto add_bytes = [&hash](const void* bytes, size_t n) {
+      for (size_t i = 0; i < n; ++i) {
+        hash ^= static_cast<const unsigned char*>(bytes)[i];
+        hash *= 1099511628211ull;
+      }
+    };
+    const uint64_t version = BANK_FILE_VERSION;
+    add_bytes(&version, sizeof(version));
+    for (size_t i = 0; i < tasks.GetSize(); ++i) {
+      const std::string& name = tasks.GetName(i);
+      add_bytes(name.c_str(), name.size() + 1);
     }
-    environment_bank.clear();
+    const uint64_t size64 = size;
+    const uint64_t unique64 = unique_outputs;
+    add_bytes(&size64, sizeof(size64));
+    add_bytes(&unique64, sizeof(unique64));
+    add_bytes(&seed, sizeof(seed));
+    return hash;
+  }
+
+  /// Standard bank file name for a given key.
+  static std::string GetBankFileName(uint64_t key) {
+    static constexpr char hex_digits[] = "0123456789abcdef";
+    std::string name("envbank-");
+    for (int shift = 60; shift >= 0; shift -= 4) name += hex_digits[(key >> shift) & 0xf];
+    return name + ".bin";
   }
 
-  size_t GetSize() const { return environment_bank.size(); }
+  /// Write this bank to a bank file. The file is written to a temporary path and then renamed, so concurrent readers
+  /// never see a partially written file. Returns false if the file couldn't be written.
+  bool SaveBank(const std::string& path, uint64_t key, int64_t seed, bool unique_outputs) const {
+    const emp::vector<std::string> task_names(GetTaskNames());
+    emp::vector<char> names_blob;
+    for (const auto& name : task_names) names_blob.insert(names_blob.end(), name.c_str(), name.c_str() + name.size() + 1);
+
+    BankFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, BANK_FILE_MAGIC, sizeof(header.magic));
+    header.version = BANK_FILE_VERSION;
+    header.byte_order = BANK_FILE_BYTE_ORDER;
+    header.key = key;
+    header.seed = seed;
+    header.num_envs = num_envs;
+    header.num_tasks = num_tasks;
+    header.num_inputs = ENV_NUM_INPUTS;
+    header.unique_outputs = unique_outputs;
+    header.value_size = sizeof(output_t);
+    header.task_names_offset = sizeof(BankFileHeader);
+    header.task_names_size = names_blob.size();
+    header.inputs_offset = AlignFileOffset(header.task_names_offset + header.task_names_size);
+    header.correct_outputs_offset = AlignFileOffset(header.inputs_offset + num_envs*ENV_NUM_INPUTS*sizeof(input_t));
+    header.sorted_outputs_offset = AlignFileOffset(header.correct_outputs_offset + num_envs*num_tasks*sizeof(output_t));
+    header.sorted_task_ids_offset = AlignFileOffset(header.sorted_outputs_offset + num_envs*num_tasks*sizeof(output_t));
+    header.collisions_offset = AlignFileOffset(header.sorted_task_ids_offset + num_envs*num_tasks*sizeof(task_id_t));
+    header.file_size = header.collisions_offset + num_envs*sizeof(uint8_t);
+
+    const std::string tmp_path(path + ".tmp");
+    {
+      std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+      if (!out) return false;
+      auto write_at = [&out](uint64_t offset, const void* bytes, size_t n) {
+        static const char zeros[8] = {0};
+        const uint64_t pos = (uint64_t)out.tellp();
+        emp_assert(pos <= offset && offset - pos < 8);
+        out.write(zeros, (std::streamsize)(offset - pos));
+        out.write(static_cast<const char*>(bytes), (std::streamsize)n);
+      };
+      write_at(0, &header, sizeof(header));
+      write_at(header.task_names_offset, names_blob.data(), names_blob.size());
+      write_at(header.inputs_offset, input_data, num_envs*ENV_NUM_INPUTS*sizeof(input_t));
+      write_at(header.correct_outputs_offset, correct_output_data, num_envs*num_tasks*sizeof(output_t));
+      write_at(header.sorted_outputs_offset, sorted_output_data, num_envs*num_tasks*sizeof(output_t));
+      write_at(header.sorted_task_ids_offset, sorted_task_id_data, num_envs*num_tasks*sizeof(task_id_t));
+      write_at(header.collisions_offset, collision_data, num_envs*sizeof(uint8_t));
+      if (!out) return false;
+    }
+    std::error_code error;
+    std::filesystem::rename(tmp_path, path, error);
+    return !error;
+  }
+
+  /// Memory-map a bank file (read-only) as this bank's environments.
+  /// Returns false (leaving the bank cleared) if the file is missing, isn't a bank file of this version and byte order,
+  /// has a different key than expected, or doesn't match this bank's task set.
+  bool LoadBank(const std::string& path, uint64_t expected_key) {
+    Clear();
+    emp::Ptr<MappedFile> file = emp::NewPtr<MappedFile>(path);
+    if (!file->IsOpen() || file->GetSize() < sizeof(BankFileHeader)) {
+      file.Delete();
+      return false;
+    }
+    BankFileHeader header;
+    std::memcpy(&header, file->GetData(), sizeof(header));
+    const size_t file_tasks = (size_t)header.num_tasks;
+    const size_t file_envs = (size_t)header.num_envs;
+    // Does the array at offset (of the given size, in bytes) fit in the file (and is it aligned)?
+    auto in_file = [&header](uint64_t offset, uint64_t bytes) {
+      return offset % 8 == 0 && offset <= header.file_size && bytes <= header.file_size - offset;
+    };
+    bool valid = std::memcmp(header.magic, BANK_FILE_MAGIC, sizeof(header.magic)) == 0
+      && header.version == BANK_FILE_VERSION
+      && header.byte_order == BANK_FILE_BYTE_ORDER
+      && header.key == expected_key
+      && header.num_inputs == ENV_NUM_INPUTS
+      && header.value_size == sizeof(output_t)
+      && file_tasks == task_set.GetSize()
+      && header.file_size == file->GetSize()
+      && in_file(header.task_names_offset, header.task_names_size)
+      && in_file(header.inputs_offset, file_envs*ENV_NUM_INPUTS*sizeof(input_t))
+      && in_file(header.correct_outputs_offset, file_envs*file_tasks*sizeof(output_t))
+      && in_file(header.sorted_outputs_offset, file_envs*file_tasks*sizeof(output_t))
+      && in_file(header.sorted_task_ids_offset, file_envs*file_tasks*sizeof(task_id_t))
+      && in_file(header.collisions_offset, file_envs*sizeof(uint8_t));
+    // Task names must match ours (in order).
+    if (valid) {
+      const char* name = file->GetData() + header.task_names_offset;
+      const char* names_end = name + header.task_names_size;
+      for (size_t i = 0; valid && i < file_tasks; ++i) {
+        const std::string& expected = task_set.GetName(i);
+        valid = (size_t)(names_end - name) > expected.size() && std::memcmp(name, expected.c_str(), expected.size() + 1) == 0;
+        name += expected.size() + 1;
+      }
+    }
+    if (!valid) {
+      file.Delete();
+      return false;
+    }
+    const char* base = file->GetData();
+    num_envs = file_envs;
+    num_tasks = file_tasks;
+    input_data = reinterpret_cast<const input_t*>(base + header.inputs_offset);
+    correct_output_data = reinterpret_cast<const output_t*>(base + header.correct_outputs_offset);
+    sorted_output_data = reinterpret_cast<const output_t*>(base + header.sorted_outputs_offset);
+    sorted_task_id_data = reinterpret_cast<const task_id_t*>(base + header.sorted_task_ids_offset);
+    collision_data = reinterpret_cast<const uint8_t*>(base + header.collisions_offset);
+    mapped_file = file;
+    return true;
+  }
+
+  size_t GetSize() const { return num_envs; }
+  size_t GetNumTasks() const { return num_tasks; }
+
+  /// Approximate memory used by the bank's environment storage (in bytes). (Mapped banks don't count; their pages
+  /// belong to the page cache and are shared across processes.)
+  size_t GetMemoryFootprint() const {
+    return inputs.capacity()*sizeof(input_t)
+      + (correct_outputs.capacity() + sorted_outputs.capacity())*sizeof(output_t)
+      + sorted_task_ids.capacity()*sizeof(task_id_t)
+      + collisions.capacity()*sizeof(uint8_t);
+  }
 
-  const Environment& GetEnvironment(size_t i) const { emp_assert(i < GetSize()); return *(environment_bank[i]); }
+  Environment GetEnvironment(size_t i) const { emp_assert(i < GetSize()); return Environment(*this, i); }
 
-  const Environment& GetRandEnv() {
+  Environment GetRandEnv() {
     emp_assert(GetSize(), "Environment bank is empty", GetSize());
-    return *(environment_bank[random.GetUInt(environment_bank.size())]);
+    return GetEnvironment(random.GetUInt(num_envs));
   }
 
 };
 
-}
\ No newline at end of file
+}
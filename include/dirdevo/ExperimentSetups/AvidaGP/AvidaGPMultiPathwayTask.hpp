@@ -9,6 +9,8 @@
 #include "emp/tools/string_utils.hpp"
 #include "emp/base/vector.hpp"
 #include "emp/datastructs/vector_utils.hpp"
+#include "emp/datastructs/map_utils.hpp"
+#include "emp/datastructs/set_utils.hpp"
 
 #include "json/json.hpp"
 
@@ -19,6 +21,7 @@
 #include "AvidaGPReplicator.hpp"
 #include "AvidaGPTaskSet.hpp"
 #include "AvidaGPEnvironmentBank.hpp"
+#include "AvidaGPPeripheral.hpp"
 
 namespace dirdevo {
 
@@ -130,18 +133,20 @@ protected:
 
   // Shared instruction set
   inst_lib_t inst_lib;
+  typename hardware_t::OpcodeTable opcode_table; ///< Decodes inst_lib for organism hardware (see SetupInstLib)
 
   // Environment/logic task information
   struct MetabolicPathway {
     size_t id=0;                                ///< Pathway id
     emp::vector<size_t> global_task_id_lookup;  ///< Lookup global-level task id given pathway-level task id
     org_task_set_t task_set;                    ///< Which tasks are part of this pathway?
-    emp::Ptr<env_bank_t> env_bank=nullptr;      ///< lookup table of IO examples
+    emp::Ptr<const env_bank_t> env_bank=nullptr; ///< lookup table of IO examples (may be shared with other worlds)
+    emp::Ptr<env_bank_t> owned_env_bank=nullptr; ///< Set if this pathway generated its own (unshared) environment bank.
 
     // todo - add a 'process' output buffer functor?
 
     ~MetabolicPathway() {
-      if (env_bank) env_bank.Delete();
+      if (owned_env_bank) owned_env_bank.Delete();
     }
   };
 
@@ -182,10 +187,12 @@ public:
 
   inst_lib_t& GetInstLib() { return inst_lib; }
   const inst_lib_t& GetInstLib() const { return inst_lib; }
+  const typename hardware_t::OpcodeTable& GetOpcodeTable() const { return opcode_table; }
+  size_t GetNumPathways() const { return task_pathways.size(); }
 
   // --- WORLD-LEVEL EVENT HOOKS ---
 
-  emp::vector<ConfigSnapshotEntry> GetConfigSnapshotEntries() override {
+  emp::vector<ConfigSnapshotEntry> GetConfigSnapshotEntries() {
     emp::vector<ConfigSnapshotEntry> entries;
     const std::string source("world__" + world.GetName() + "__task");
     std::ostringstream stream;
@@ -269,7 +276,7 @@ public:
   }
 
   /// OnWorldSetup called at end of constructor/world setup
-  void OnWorldSetup() override {
+  void OnWorldSetup() {
     // Configure individual and world logic tasks.
     SetupTasks();
     // Configure merit calculation
@@ -283,15 +290,15 @@ public:
   }
 
   /// OnBeforeWorldUpdate is called at the beginning of running the world update
-  void OnBeforeWorldUpdate(size_t update) override {
+  void OnBeforeWorldUpdate(size_t update) {
     // as soon as the world has updated, evaluation is no longer guaranteed to be fresh
     fresh_eval=false;
   }
 
   /// OnWorldUpdate is called when the OnUpdate signal is triggered (at the end of a world update)
-  void OnWorldUpdate(size_t update) override { /*todo*/ }
+  void OnWorldUpdate(size_t update) { /*todo*/ }
 
-  void OnWorldReset() override {
+  void OnWorldReset() {
     // Reset task performance counts
     std::fill(
       task_performance.begin(),
@@ -309,7 +316,7 @@ public:
   }
 
   /// Evaluate the world on this task.
-  void Evaluate() override {
+  void Evaluate() {
 
     #ifndef EMP_NDEBUG
     // Verbose print statements in debug mode.
@@ -340,18 +347,25 @@ public:
 
   // --- ORGANISM-LEVEL EVENT HOOKS ---
   // These are always called AFTER the organism's equivalent functions.
-  void OnOrgInjectReady(org_t& org) override {
+  void OnOrgInjectReady(org_t& org) {
     // Anything that happens OnOffspringReady might also need to happen here (injected organisms are never offspring)
     emp_assert(total_tasks == task_info.size());
     org.GetPhenotype().Reset(total_tasks);
     org.SetMerit(1.0); // Injected organisms have merit set to 1
   }
 
-  /// Called when parent is about to reproduce, but before an offspring has been constructed.
-  void OnBeforeOrgRepro(org_t & parent) override { /*todo*/ }
+  /// Bind each of org's pathways to a random environment from that pathway's environment bank.
+  /// Organisms read inputs straight from the bank (environment banks outlive the world's organisms).
+  void AssignRandomEnvironments(org_t& org) {
+    for (size_t pathway_id = 0; pathway_id < task_pathways.size(); ++pathway_id) {
+      const auto& env_bank = *(task_pathways[pathway_id].env_bank);
+      const size_t env_id = world.GetRandom().GetUInt(env_bank.GetSize());
+      org.GetHardware().BindEnvironment(pathway_id, env_id, env_bank.GetEnvironment(env_id).GetInputBuffer());
+    }
+  }
 
   /// Called when the offspring has been constructed but has not been placed yet.
-  void OnOffspringReady(org_t& offspring, org_t& parent) override {
+  void OnOffspringReady(org_t& offspring, org_t& parent) {
     // Calculate merit based on parent's phenotype.
     const double merit = calc_merit_fun(parent);
     emp_assert(merit > 0, merit, parent.GetMerit());
@@ -364,20 +378,8 @@ public:
     offspring.SetMerit(merit);
     parent.SetMerit(merit);
 
-    // Parent gets reset, but doesn't get placed again (no OnPlacement sig). Need to give it a new environment and reset its input buffer.
-    for (size_t pathway_id = 0; pathway_id < task_pathways.size(); ++pathway_id) {
-      auto& pathway = task_pathways[pathway_id];
-      const size_t parent_env_id = world.GetRandom().GetUInt(pathway.env_bank->GetSize());
-      parent.GetHardware().SetEnvID(pathway_id, parent_env_id);
-
-      // auto& parent_in_buffer = parent.GetHardware().GetInputBuffer(pathway_id);
-      // auto& env_in_buffer = pathway.env_bank->GetEnvironment(parent_env_id).input_buffer;
-      // parent_in_buffer.resize(env_in_buffer.size());
-      // for (size_t i = 0; i < parent_in_buffer.size(); ++i) parent_in_buffer[i] = env_in_buffer[i];
-
-      parent.GetHardware().GetInputBuffer(pathway_id) = pathway.env_bank->GetEnvironment(parent_env_id).input_buffer;
-
-    }
+    // Parent gets reset, but doesn't get placed again (no OnPlacement sig). Need to give it a new environment.
+    AssignRandomEnvironments(parent);
   }
 
   /// Sydney
@@ -387,52 +389,30 @@ public:
     parent.GetPhenotype().Reset(total_tasks);
     parent.SetMerit(merit);
 
-    // Parent gets reset, but doesn't get placed again (no OnPlacement sig). Need to give it a new environment and reset its input buffer.
-    for (size_t pathway_id = 0; pathway_id < task_pathways.size(); ++pathway_id) {
-      auto& pathway = task_pathways[pathway_id];
-      const size_t parent_env_id = world.GetRandom().GetUInt(pathway.env_bank->GetSize());
-      parent.GetHardware().SetEnvID(pathway_id, parent_env_id);
-      parent.GetHardware().GetInputBuffer(pathway_id) = pathway.env_bank->GetEnvironment(parent_env_id).input_buffer;
-    }
+    // Parent gets reset, but doesn't get placed again (no OnPlacement sig). Need to give it a new environment.
+    AssignRandomEnvironments(parent);
   }
 
   /// Called when org is being placed (@ position) in the world
-  void OnOrgPlacement(org_t& org, size_t position) override {
-    const size_t num_pathways = task_pathways.size();
-    org.SetNumPathways(num_pathways); // Configure organism's number of metabolic pathways
-    // Assign organism an environment ID for each pathway
-    for (size_t pathway_id = 0; pathway_id < num_pathways; ++pathway_id) {
-      auto& pathway = task_pathways[pathway_id];
-      auto& env_bank = *(pathway.env_bank);
-      const size_t env_id = world.GetRandom().GetUInt(env_bank.GetSize());
-      org.GetHardware().SetEnvID(pathway_id, env_id);
-      // Configure organism's input buffer
-      // auto& org_in_buffer = org.GetHardware().GetInputBuffer(pathway_id);
-      // auto& env_in_buffer = env_bank.GetEnvironment(env_id).input_buffer;
-      // org_in_buffer.resize(env_in_buffer.size());
-      // for (size_t i = 0; i < org_in_buffer.size(); ++i) org_in_buffer[i] = env_in_buffer[i];
-
-      org.GetHardware().GetInputBuffer(pathway_id) = env_bank.GetEnvironment(env_id).input_buffer;
-      // emp_assert(org.GetHardware().GetInputBuffer(pathway_id) == env_bank.GetEnvironment(env_id).input_buffer);
-    }
+  void OnOrgPlacement(org_t& org, size_t position) {
+    org.SetNumPathways(task_pathways.size()); // Configure organism's number of metabolic pathways
+    AssignRandomEnvironments(org);            // Assign organism an environment for each pathway
+    org.GetHardware().SetOpcodeTable(&opcode_table);
   }
 
-  /// Called just before the organism's process step function is called.
-  void BeforeOrgProcessStep(org_t& org) override { /*todo*/ }
-
   /// Called just after the organism's process step function is called.
-  void AfterOrgProcessStep(org_t& org) override {
+  void AfterOrgProcessStep(org_t& org) {
     // Analyze organism output buffer for each metabolic pathway
     const size_t num_pathways = task_pathways.size();
     for (size_t pathway_id = 0; pathway_id < num_pathways; ++pathway_id) {
       auto& output_buffer = org.GetHardware().GetOutputBuffer(pathway_id);
       auto& pathway = task_pathways[pathway_id];
+      const auto env = pathway.env_bank->GetEnvironment(org.GetHardware().GetEnvID(pathway_id));
       for (auto value : output_buffer) {
         // Is this value the correct output to any of the tasks?
-        const auto& env = pathway.env_bank->GetEnvironment(org.GetHardware().GetEnvID(pathway_id));
-        if (emp::Has(env.valid_outputs, value)) {
-          emp_assert(env.task_lookup.find(value)->second.size() == 1, "Environment should guarantee unique output for each operation");
-          const size_t local_task_id = env.task_lookup.find(value)->second[0];
+        const size_t local_task_id = env.GetTaskID(value);
+        if (local_task_id != env_bank_t::NO_TASK) {
+          emp_assert(env.CountTasks(value) == 1, "Environment should guarantee unique output for each operation");
           const size_t global_task_id = pathway.global_task_id_lookup[local_task_id];
           // TODO - this is where we would implement/check for task requirements
 
@@ -450,15 +430,18 @@ public:
       output_buffer.clear();  // Clear the output buffer after processing
     }
     // Is organism still alive?
-    const size_t age_limit = org.GetGenome().GetSize()*world.config.AVIDAGP_ORG_AGE_LIMIT();
-    org.SetDead(org.GetAge() >= age_limit);
+    org.SetDead(org.GetAge() >= GetOrgAgeLimit(org));
   }
 
-  /// Called before organism is removed from the world.
-  void OnOrgDeath(org_t& org, size_t position) override { /*todo*/ }
+  /// Steps left before org reaches its age limit (the world won't run org past it, even with multi-step time slices).
+  size_t GetOrgStepsRemaining(const org_t& org) const {
+    const size_t age_limit = GetOrgAgeLimit(org);
+    return (org.GetAge() < age_limit) ? age_limit - org.GetAge() : 0;
+  }
 
-  /// Called after two organisms are swapped in the world (new world positions are accurate).
-  void AfterOrgSwap(org_t& org1, org_t& org2) override { /*todo*/ }
+  size_t GetOrgAgeLimit(const org_t& org) const {
+    return org.GetGenome().GetSize()*world.config.AVIDAGP_ORG_AGE_LIMIT();
+  }
 
 };
 
@@ -501,9 +484,7 @@ void AvidaGPMultiPathwayTask::SetupInstLib() {
   // Add instruction: Nop
   inst_lib.AddInst(
     "Nop",
-    [](hardware_t& hw, const hardware_t::inst_t& inst) {
-      return;
-    },
+    hardware_t::Inst_Nop,
     0,
     "No operation"
   );
@@ -511,10 +492,7 @@ void AvidaGPMultiPathwayTask::SetupInstLib() {
   // Add instruction: CopyInst
   inst_lib.AddInst(
     "CopyInst",
-    [](hardware_t& hw, const hardware_t::inst_t& inst) {
-      if (hw.IsDoneCopying()) return; // Don't over-copy.
-      hw.IncSitesCopied();            // 'Copy' an instruction.
-    },
+    hardware_t::Inst_CopyInst,
     0,
     "Copy next instrution"
   );
@@ -522,9 +500,7 @@ void AvidaGPMultiPathwayTask::SetupInstLib() {
   // Add instruction: GetLen
   inst_lib.AddInst(
     "GetLen",
-    [](hardware_t& hw, const hardware_t::inst_t& inst) {
-      hw.regs[inst.args[0]] = hw.GetSize();
-    },
+    hardware_t::Inst_GetLen,
     1,
     "REG[ARG0]=ProgramSize"
   );
@@ -534,10 +510,7 @@ void AvidaGPMultiPathwayTask::SetupInstLib() {
   // Add divide instruction
   inst_lib.AddInst(
     "DivideSelf",
-    [](hardware_t& hw, const hardware_t::inst_t& inst) {
-      hw.SetDividing(hw.IsDoneCopying());
-      hw.IncFailedSelfDivisions((size_t)!hw.IsDividing());
-    },
+    hardware_t::Inst_DivideSelf,
     0,
     "Mark hardware unit for self-replication"
   );
@@ -545,9 +518,7 @@ void AvidaGPMultiPathwayTask::SetupInstLib() {
   // Add nand instruction
   inst_lib.AddInst(
     "Nand",
-    [](hardware_t& hw, const hardware_t::inst_t& inst) {
-      hw.regs[inst.args[2]] = ~((uint32_t)hw.regs[inst.args[0]]&(uint32_t)hw.regs[inst.args[1]]);
-    },
+    hardware_t::Inst_Nand,
     3,
     "REG[ARG3]=~(REG[ARG1]&REG[ARG2])"
   );
@@ -558,12 +529,7 @@ void AvidaGPMultiPathwayTask::SetupInstLib() {
     inst_lib.AddInst(
       emp::to_string("Input-", pathway_id),
       [pathway_id](hardware_t& hw, const hardware_t::inst_t& inst) {
-        const auto& input_buffer = hw.GetInputBuffer(pathway_id);
-        emp_assert(input_buffer.size(), "Input buffer should contain at least one element", pathway_id, input_buffer.size());
-        const size_t input_ptr = hw.AdvanceInputPointer(pathway_id);    // Returns the current input pointer value and then advances the pointer.
-        emp_assert(input_ptr < input_buffer.size(), input_ptr, input_buffer.size());
-        const auto input_val = input_buffer[input_ptr];
-        hw.regs[inst.args[0]] = input_val;
+        hardware_t::Inst_Input(hw, inst, pathway_id);
       },
       1,
       "REG[ARG0]=NextInput"
@@ -573,12 +539,15 @@ void AvidaGPMultiPathwayTask::SetupInstLib() {
     inst_lib.AddInst(
       emp::to_string("Output-", pathway_id),
       [pathway_id](hardware_t& hw, const hardware_t::inst_t& inst) {
-        hw.GetOutputBuffer(pathway_id).emplace_back(hw.regs[inst.args[0]]);
+        hardware_t::Inst_Output(hw, inst, pathway_id);
       },
       1,
       "Push REG[ARG0] to output buffer"
     );
   }
+
+  // Decode instructions by name for the hardware's pre-decoded interpreter.
+  opcode_table.Build(inst_lib);
 }
 
 void AvidaGPMultiPathwayTask::SetupTasks() {
@@ -600,6 +569,10 @@ void AvidaGPMultiPathwayTask::SetupTasks() {
 
   // How many pathways are there?
   const size_t num_pathways = env_json["pathways"];
+  if (num_pathways > hardware_t::MAX_NUM_PATHWAYS) {
+    std::cout << "Environment file requests " << num_pathways << " pathways, but AvidaGP hardware supports at most " << hardware_t::MAX_NUM_PATHWAYS << " (see DIRDEVO_AVIDAGP_MAX_PATHWAYS)." << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
 
   // Create metabolic pathways
   task_pathways.resize(num_pathways);
@@ -613,7 +586,6 @@ void AvidaGPMultiPathwayTask::SetupTasks() {
   for (size_t pathway_id=0; pathway_id < task_pathways.size(); ++pathway_id) {
     auto& pathway = task_pathways[pathway_id];
     pathway.id = 0;
-    pathway.env_bank = emp::NewPtr<env_bank_t>(world.GetRandom(), pathway.task_set);
   }
 
   // Configure organism-level tasks
@@ -669,6 +641,13 @@ void AvidaGPMultiPathwayTask::SetupTasks() {
   }
 
 
+  // Are environment banks shared across worlds? (only if the experiment gave us an AvidaGP peripheral that shares them)
+  emp::Ptr<AvidaGPPeripheral> shared_banks = nullptr;
+  if (world.GetPeripheral()) {
+    auto* agp_peripheral = dynamic_cast<AvidaGPPeripheral*>(world.GetPeripheral().Raw());
+    if (agp_peripheral && agp_peripheral->SharesEnvironmentBanks()) shared_banks = agp_peripheral;
+  }
+
   // Update pathways with tasks
   total_tasks = 0;
   for (size_t pathway_id=0; pathway_id < task_pathways.size(); ++pathway_id) {
@@ -715,7 +694,18 @@ void AvidaGPMultiPathwayTask::SetupTasks() {
       }
       pathway.global_task_id_lookup[local_task_id] = global_task_id;
     }
-    pathway.env_bank->GenerateBank(world.GetConfig().AVIDAGP_ENV_BANK_SIZE(), world.GetConfig().AVIDAGP_UNIQUE_ENV_OUTPUT());
+    // Use the experiment's shared environment bank for this pathway if there is one; otherwise, generate our own.
+    if (shared_banks) {
+      pathway.env_bank = shared_banks->GetEnvironmentBank(
+        pathway.task_set,
+        world.GetConfig().AVIDAGP_ENV_BANK_SIZE(),
+        world.GetConfig().AVIDAGP_UNIQUE_ENV_OUTPUT()
+      );
+    } else {
+      pathway.owned_env_bank = emp::NewPtr<env_bank_t>(world.GetRandom(), pathway.task_set);
+      pathway.owned_env_bank->GenerateBank(world.GetConfig().AVIDAGP_ENV_BANK_SIZE(), world.GetConfig().AVIDAGP_UNIQUE_ENV_OUTPUT());
+      pathway.env_bank = pathway.owned_env_bank;
+    }
     total_tasks += num_tasks;
   }
 
@@ -5,12 +5,15 @@
 #include <algorithm>
 #include <numeric>
 
+#include "emp/base/Ptr.hpp"
 #include "emp/config/config.hpp"
 #include "emp/math/Random.hpp"
 #include "emp/tools/string_utils.hpp"
 #include "emp/hardware/AvidaGP.hpp"
 #include "emp/math/Range.hpp"
 
+#include "../../mutator/GeometricSkip.hpp"
+#include "../../utility/MutationDelta.hpp"
 #include "AvidaGPReplicator.hpp"
 
 namespace dirdevo {
@@ -36,6 +39,12 @@ public:
       exp_config["AVIDAGP_MUT_RATE_ARG_SUB"]->GetValue()
     );
 
+    if (exp_config.Has("MUTATION_SAMPLING")) {
+      mutator.sampling = ParseMutationSampling(exp_config["MUTATION_SAMPLING"]->GetValue());
+    }
+    mutator.inst_substitution_skip.SetRate(mutator.rate_inst_substitution);
+    mutator.arg_substitution_skip.SetRate(mutator.rate_arg_substitution);
+
   }
 
 protected:
@@ -44,31 +53,59 @@ protected:
   double rate_inst_substitution=0;
   double rate_arg_substitution=0;
 
+  MutationSampling sampling=MutationSampling::PER_SITE;
+  GeometricSkip inst_substitution_skip;
+  GeometricSkip arg_substitution_skip;  ///< Argument sites are numbered inst_i * INST_ARGS + arg_i
+
 public:
 
-  // TODO - enable more sophisticated mutation tracking
+  using fields_t = GenomeFields<genome_t>;
+
   size_t Mutate(genome_t& genome, emp::Random& random) {
+    return Mutate(genome, random, nullptr);
+  }
+
+  /// Mutate genome, returning the number of substitutions. If delta isn't null, it's cleared and then records each
+  /// substitution (see MutationDelta; sites are numbered by GenomeFields<genome_t>).
+  size_t Mutate(genome_t& genome, emp::Random& random, emp::Ptr<MutationDelta> delta) {
     // TODO - implement single instruction deletion/mutation?
     size_t count=0;
+    if (delta) delta->clear();
     const size_t inst_lib_size = genome.GetInstLib()->GetSize();
+    auto set_id = [&](size_t inst_i, size_t id) {
+      if (delta) delta->Record(fields_t::IdSite(inst_i), (uint32_t)genome[inst_i].id, (uint32_t)id);
+      genome[inst_i].id = id;
+      ++count;
+    };
+    auto set_arg = [&](size_t inst_i, size_t arg_i, size_t arg) {
+      if (delta) delta->Record(fields_t::ArgSite(inst_i, arg_i), (uint32_t)genome[inst_i].args[arg_i], (uint32_t)arg);
+      genome[inst_i].args[arg_i] = arg;
+      ++count;
+    };
+    if (sampling == MutationSampling::SKIP) {
+      inst_substitution_skip.ForEachHit(genome.GetSize(), random, [&](size_t inst_i) {
+        set_id(inst_i, random.GetUInt(inst_lib_size));
+      });
+      arg_substitution_skip.ForEachHit(genome.GetSize() * INST_ARGS, random, [&](size_t arg_site) {
+        set_arg(arg_site / INST_ARGS, arg_site % INST_ARGS, random.GetUInt(CPU_SIZE));
+      });
+      return count;
+    }
     for (size_t inst_i = 0; inst_i < genome.GetSize(); ++inst_i) {
       // Mutate instruction operation
       if (random.P(rate_inst_substitution)) {
-        genome[inst_i].id = random.GetUInt(inst_lib_size);
-        ++count;
+        set_id(inst_i, random.GetUInt(inst_lib_size));
       }
       // Mutate arguments
       for (size_t arg_i = 0; arg_i < INST_ARGS; ++arg_i) {
         if (random.P(rate_arg_substitution)) {
-          genome[inst_i].args[arg_i] = random.GetUInt(CPU_SIZE);
-          ++count;
+          set_arg(inst_i, arg_i, random.GetUInt(CPU_SIZE));
         }
       }
     }
     return count;
   }
 
-
 };
 
 } // namespace dirdevo
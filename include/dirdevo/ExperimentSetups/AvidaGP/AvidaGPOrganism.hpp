@@ -5,6 +5,8 @@
 #include "emp/hardware/Genome.hpp"
 #include "emp/hardware/AvidaGP.hpp"
 
+#include "../../utility/MutationDelta.hpp"
+#include "../../utility/ZobristHash.hpp"
 #include "AvidaGPReplicator.hpp"
 
 // STATUS: In progress
@@ -77,6 +79,8 @@ protected:
   // sgp_cpu_t cpu;
   phenotype_t phenotype;
   hardware_t hardware;
+  MutationDelta birth_delta; ///< Substitutions made to this organism's genome at birth (relative to its parent's genome).
+  uint64_t genome_hash=0;    ///< ZobristHash of the genome (valid once born or injected; see GetGenomeHash).
 
   size_t age = 0;
   size_t generation = 0;
@@ -96,11 +100,37 @@ public:
 
   }
 
+  /// Reinitialize this organism in place (as if constructed from g) without giving up its allocated buffers.
+  /// Used by OrganismPool.
+  void Recycle(const genome_t& g) {
+    base_t::ResetBaseOrganism();
+    hardware.Recycle(g);
+    phenotype.Reset();
+    birth_delta.clear();
+    age=0;
+    generation=0;
+    cpu_cycles_since_division=0;
+    cpu_cycles_per_replication=0;
+  }
+
   genome_t & GetGenome() { return hardware.genome; }
   const genome_t & GetGenome() const { return hardware.genome; }
   phenotype_t & GetPhenotype() { return phenotype; }
   const phenotype_t & GetPhenotype() const { return phenotype; }
 
+  MutationDelta& GetBirthDelta() { return birth_delta; }
+  const MutationDelta& GetBirthDelta() const { return birth_delta; }
+
+  /// Hash of this organism's genome. Injected organisms hash their genome in full; offspring update their parent's hash
+  /// with their birth delta, so it costs O(mutations) rather than O(genome length).
+  /// Anything that changes the genome outside of birth/injection must call RefreshGenomeHash (or SetGenomeHash).
+  uint64_t GetGenomeHash() const {
+    emp_assert(genome_hash == ZobristHash(GetGenome()), "Stale genome hash.");
+    return genome_hash;
+  }
+  void SetGenomeHash(uint64_t hash) { genome_hash = hash; }
+  void RefreshGenomeHash() { genome_hash = ZobristHash(GetGenome()); }
+
   hardware_t& GetHardware() { return hardware; }
   const hardware_t& GetHardware() const { return hardware; }
 
@@ -115,8 +145,10 @@ public:
     hardware.SetNumPathways(n_pathways);
   }
 
-  void OnInjectReady() override {
+  void OnInjectReady() {
     hardware.ResetReplicatorHardware();
+    birth_delta.clear();
+    RefreshGenomeHash();
     dead=false;
     repro_ready=false;
     new_born=true;
@@ -125,9 +157,7 @@ public:
     is_parent=false;
   }
 
-  void OnBeforeRepro() override { }
-
-  void OnOffspringReady(this_t& offspring) override {
+  void OnOffspringReady(this_t& offspring) {
     // Reset this (the parent) organism's hardware + reproduction status
     hardware.ResetReplicatorHardware();
     repro_ready=false;
@@ -135,13 +165,15 @@ public:
     cpu_cycles_since_division=0;
   }
 
-  void OnPlacement(size_t position) override {
+  void OnPlacement(size_t position) {
     // let hardware know where it exists in the world
     hardware.SetWorldID(position);
   }
 
-  void OnBirth(this_t& parent) override {
+  void OnBirth(this_t& parent) {
     // note, this happens before parent's OnOffspringReady is called
+    // note, this also happens after mutations, so birth_delta is this organism's full set of mutations
+    genome_hash = UpdateZobristHash(parent.GetGenomeHash(), birth_delta);
     hardware.ResetReplicatorHardware(); // Reset AvidaGP virtual hardware
     dead=false;
     repro_ready=false;
@@ -156,13 +188,11 @@ public:
     generation=parent.GetGeneration();
   }
 
-  void OnDeath(size_t position) override { /*TODO*/ }
-
   template<typename WORLD_T>
   void ProcessStep(WORLD_T& world) {
     // TODO - fill out process step
     // Advance virtual CPU by one step
-    hardware.SingleProcess();
+    hardware.Step();
     // Is this organism reproducing?
     repro_ready = hardware.IsDividing();
     // Age up
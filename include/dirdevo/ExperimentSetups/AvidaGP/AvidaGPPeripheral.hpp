@@ -0,0 +1,153 @@
+#pragma once
+#ifndef DIRECTED_DEVO_AVIDAGP_PERIPHERAL_HPP_INCLUDE
+#define DIRECTED_DEVO_AVIDAGP_PERIPHERAL_HPP_INCLUDE
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/Ptr.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/math/Random.hpp"
+
+#include "../../BasePeripheral.hpp"
+
+#include "AvidaGPTaskSet.hpp"
+#include "AvidaGPEnvironmentBank.hpp"
+
+namespace dirdevo {
+
+/// Experiment-level equipment for AvidaGP experiments.
+/// Holds environment banks that are built once and shared (read-only) by every world in the experiment. Banks are keyed
+/// by their pathway's task list (in order), size, output uniqueness, and the bank seed, so worlds configured from the
+/// same environment file end up sharing the same banks.
+/// If AVIDAGP_ENV_BANK_DIR is set, banks are memory-mapped from prebuilt bank files in that directory when possible
+/// (see source/envbank-gen.cpp), and only generated if no matching file exists.
+/// NOTE - GetEnvironmentBank is not thread safe; worlds request banks during their construction (which the experiment
+///        does sequentially in Setup).
+class AvidaGPPeripheral : public BasePeripheral {
+public:
+  using task_set_t = AvidaGPTaskSet;
+  using env_bank_t = AvidaGPEnvironmentBank;
+
+protected:
+
+  struct SharedEnvironmentBank {
+    emp::vector<std::string> task_names;  ///< Tasks (in task id order) the bank was built for.
+    size_t size=0;
+    bool unique_outputs=true;
+    uint64_t key=0;                       ///< Bank file key (see AvidaGPEnvironmentBank::GetBankKey)
+    emp::Ptr<task_set_t> task_set=nullptr; ///< The bank's own copy of the task set (the bank holds a reference to it).
+    emp::Ptr<emp::Random> random=nullptr;  ///< Used (only) to generate this bank.
+    emp::Ptr<env_bank_t> env_bank=nullptr;
+  };
+
+  bool share_env_banks=true;
+  int64_t bank_seed=0;       ///< Seed that (along with each bank's key) determines generated banks.
+  std::string bank_dir;      ///< Where to look for prebuilt bank files (empty: don't).
+  size_t num_threads=1;      ///< Threads used to generate banks (0: all hardware threads).
+  emp::vector<SharedEnvironmentBank> env_banks;
+
+  static emp::vector<std::string> GetTaskNames(const task_set_t& task_set) {
+    emp::vector<std::string> names(task_set.GetSize());
+    for (size_t i = 0; i < names.size(); ++i) names[i] = task_set.GetName(i);
+    return names;
+  }
+
+  /// Bank files are only meaningful for reproducible (explicitly seeded) banks.
+  bool UseBankFiles() const { return bank_dir != "" && bank_seed > 0; }
+
+public:
+
+  AvidaGPPeripheral() = default;
+  AvidaGPPeripheral(const AvidaGPPeripheral&) = delete;
+  AvidaGPPeripheral& operator=(const AvidaGPPeripheral&) = delete;
+
+  ~AvidaGPPeripheral() { Clear(); }
+
+  void Setup(const config_t& cfg) {
+    Clear();
+    share_env_banks = cfg.AVIDAGP_SHARED_ENV_BANK();
+    bank_seed = (cfg.AVIDAGP_ENV_BANK_SEED() < 0) ? cfg.SEED() : cfg.AVIDAGP_ENV_BANK_SEED();
+    bank_dir = cfg.AVIDAGP_ENV_BANK_DIR();
+    num_threads = cfg.NUM_THREADS();
+  }
+
+  /// Delete all shared environment banks.
+  /// WARNING - invalidates any bank handed out by GetEnvironmentBank.
+  void Clear() {
+    for (auto& shared_bank : env_banks) {
+      shared_bank.env_bank.Delete();
+      shared_bank.random.Delete();
+      shared_bank.task_set.Delete();
+    }
+    env_banks.clear();
+  }
+
+  bool SharesEnvironmentBanks() const { return share_env_banks; }
+  size_t GetNumEnvironmentBanks() const { return env_banks.size(); }
+  int64_t GetBankSeed() const { return bank_seed; }
+  const std::string& GetBankDir() const { return bank_dir; }
+
+  /// Get the shared environment bank for the given task set (loading or building it if this is the first request for it).
+  /// The returned bank is owned by the peripheral and lives until the peripheral is cleared or destroyed.
+  emp::Ptr<const env_bank_t> GetEnvironmentBank(const task_set_t& task_set, size_t size, bool unique_outputs) {
+    emp_assert(share_env_banks);
+    const emp::vector<std::string> task_names(GetTaskNames(task_set));
+    const uint64_t key = env_bank_t::GetBankKey(task_set, size, unique_outputs, bank_seed);
+    for (const auto& shared_bank : env_banks) {
+      if (shared_bank.key == key && shared_bank.size == size && shared_bank.unique_outputs == unique_outputs && shared_bank.task_names == task_names) {
+        return shared_bank.env_bank;
+      }
+    }
+    auto& shared_bank = env_banks.emplace_back();
+    shared_bank.task_names = task_names;
+    shared_bank.size = size;
+    shared_bank.unique_outputs = unique_outputs;
+    shared_bank.key = key;
+    shared_bank.task_set = emp::NewPtr<task_set_t>();
+    shared_bank.task_set->AddTasksByName(task_names);
+    // Each bank gets its own generator (seeded from its key), so bank contents don't depend on request order.
+    shared_bank.random = emp::NewPtr<emp::Random>((int)(key % 2147483646) + 1);
+    shared_bank.env_bank = emp::NewPtr<env_bank_t>(*shared_bank.random, *shared_bank.task_set);
+    if (UseBankFiles()) {
+      const std::string path(GetBankPath(key));
+      if (shared_bank.env_bank->LoadBank(path, key)) {
+        std::cout << "Mapped environment bank from " << path << std::endl;
+        return shared_bank.env_bank;
+      }
+      std::cout << "No usable prebuilt environment bank at " << path << "; generating it." << std::endl;
+    }
+    shared_bank.env_bank->GenerateBank(size, unique_outputs, num_threads);
+    std::cout << "Generated environment bank (" << size << " environments, " << task_names.size() << " tasks) in ";
+    std::cout << shared_bank.env_bank->GetGenerationTime() << "s using " << shared_bank.env_bank->GetGenerationThreads() << " thread(s)";
+    std::cout << " (" << shared_bank.env_bank->GetGenerationThroughput() << " environments/s)." << std::endl;
+    return shared_bank.env_bank;
+  }
+
+  /// Path of the bank file with the given key (in the configured bank directory).
+  std::string GetBankPath(uint64_t key) const {
+    return (std::filesystem::path(bank_dir) / env_bank_t::GetBankFileName(key)).string();
+  }
+
+  /// Write every generated (i.e., not already mapped from a file) bank to the bank directory.
+  /// Returns the number of bank files written, or -1 if bank files aren't usable (no directory or no explicit seed) or
+  /// a file couldn't be written.
+  int SaveEnvironmentBanks() const {
+    if (!UseBankFiles()) return -1;
+    int num_saved = 0;
+    for (const auto& shared_bank : env_banks) {
+      if (shared_bank.env_bank->IsMapped()) continue;
+      const std::string path(GetBankPath(shared_bank.key));
+      if (!shared_bank.env_bank->SaveBank(path, shared_bank.key, bank_seed, shared_bank.unique_outputs)) return -1;
+      ++num_saved;
+    }
+    return num_saved;
+  }
+
+};
+
+} // namespace dirdevo
+
+#endif // #ifndef DIRECTED_DEVO_AVIDAGP_PERIPHERAL_HPP_INCLUDE
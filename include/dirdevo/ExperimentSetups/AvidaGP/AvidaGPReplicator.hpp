@@ -2,30 +2,156 @@
 #ifndef DIRECTED_DEVO_DIRECTED_DEVO_AVIDAGP_REPLICATOR_HARDWARE_HPP_INCLUDE
 #define DIRECTED_DEVO_DIRECTED_DEVO_AVIDAGP_REPLICATOR_HARDWARE_HPP_INCLUDE
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <string>
 
 #include "emp/hardware/Genome.hpp"
 #include "emp/hardware/AvidaGP.hpp"
 #include "emp/base/vector.hpp"
 
 #include "../../BaseOrganism.hpp"
+#include "../../utility/GenomeInternTable.hpp"
+#include "../../utility/InlineBuffer.hpp"
+#include "../../utility/MutationDelta.hpp"
 
 // STATUS: In progress
 
 namespace dirdevo {
 
 
+#ifndef DIRDEVO_AVIDAGP_MAX_PATHWAYS
+#define DIRDEVO_AVIDAGP_MAX_PATHWAYS 3
+#endif
+
 /// Based on emp::AvidaGP class. Tacks on some hardware components for tracking self-replication.
-class AvidaGPReplicator : public emp::AvidaCPU_Base<AvidaGPReplicator> {
+/// Per-pathway state lives in fixed-capacity inline storage (our environments use 1-3 metabolic pathways):
+/// - MAX_PATHWAYS: maximum number of metabolic pathways.
+/// - OUTPUT_CAPACITY: number of outputs each pathway's output buffer holds inline (more outputs between clears spill to the heap).
+/// Input buffers are non-owning views onto the environment bank's input buffers (see BindEnvironment), so Input-N
+/// instructions read straight from the environment and assigning an environment doesn't copy or allocate.
+/// Execution: Step() runs the next instruction. If the hardware has an OpcodeTable for its instruction library (see
+/// SetOpcodeTable), the genome is decoded once into a compact opcode stream and run with a switch that calls each
+/// instruction's implementation directly (instead of through the library's std::function table). Results are identical
+/// to SingleProcess (which is what Step falls back to without a table, or when compiled with
+/// DIRDEVO_AVIDAGP_LIBRARY_INTERPRETER).
+template<size_t MAX_PATHWAYS, size_t OUTPUT_CAPACITY>
+class BasicAvidaGPReplicator : public emp::AvidaCPU_Base<BasicAvidaGPReplicator<MAX_PATHWAYS, OUTPUT_CAPACITY>> {
 public:
-  using base_t = AvidaCPU_Base<AvidaGPReplicator>;
+  using this_t = BasicAvidaGPReplicator<MAX_PATHWAYS, OUTPUT_CAPACITY>;
+  using base_t = emp::AvidaCPU_Base<this_t>;
   using typename base_t::genome_t;
   using typename base_t::inst_lib_t;
+  using typename base_t::inst_t;
 
   using input_t = double;
   using output_t = double;
-  using input_buffer_t = emp::vector<input_t>;
-  using output_buffer_t = emp::vector<output_t>;
+  using input_buffer_t = BufferView<input_t>;
+  using output_buffer_t = InlineBuffer<output_t, OUTPUT_CAPACITY>;
+
+  static constexpr size_t MAX_NUM_PATHWAYS = MAX_PATHWAYS;
+
+  /// What the pre-decoded interpreter does for an instruction.
+  enum class Opcode : uint8_t {
+    Nop, Inc, Dec, Not, SetReg, Add, Sub, Mult, Div, Mod, TestEqu, TestNEqu, TestLess,
+    If, While, Countdown, Break, Scope, Define, Call, Push, Pop, CopyVal, ScopeReg,
+    CopyInst, GetLen, DivideSelf, Nand, Input, Output
+  };
+
+  struct DecodedInst {
+    Opcode op=Opcode::Nop;
+    uint8_t pathway=0;   ///< Pathway used by Input/Output.
+  };
+
+  /// Maps an instruction library's instruction ids to opcodes. Instructions are recognized by name, so the library must
+  /// give these names their standard implementations (the AvidaCPU_InstLib Inst_* functions and this class's Inst_*
+  /// functions, as the AvidaGP tasks' SetupInstLib functions do). If any instruction isn't recognized, the table is
+  /// incomplete and hardware using it falls back to library dispatch.
+  class OpcodeTable {
+  protected:
+    emp::vector<DecodedInst> by_inst_id;
+    bool complete=false;
+
+    static bool DecodeName(const std::string& name, DecodedInst& decoded) {
+      static const std::array<std::pair<const char*, Opcode>, 28> named_ops{{
+        {"Nop", Opcode::Nop}, {"Inc", Opcode::Inc}, {"Dec", Opcode::Dec}, {"Not", Opcode::Not},
+        {"SetReg", Opcode::SetReg}, {"Add", Opcode::Add}, {"Sub", Opcode::Sub}, {"Mult", Opcode::Mult},
+        {"Div", Opcode::Div}, {"Mod", Opcode::Mod}, {"TestEqu", Opcode::TestEqu}, {"TestNEqu", Opcode::TestNEqu},
+        {"TestLess", Opcode::TestLess}, {"If", Opcode::If}, {"While", Opcode::While}, {"Countdown", Opcode::Countdown},
+        {"Break", Opcode::Break}, {"Scope", Opcode::Scope}, {"Define", Opcode::Define}, {"Call", Opcode::Call},
+        {"Push", Opcode::Push}, {"Pop", Opcode::Pop}, {"CopyVal", Opcode::CopyVal}, {"ScopeReg", Opcode::ScopeReg},
+        {"CopyInst", Opcode::CopyInst}, {"GetLen", Opcode::GetLen}, {"DivideSelf", Opcode::DivideSelf}, {"Nand", Opcode::Nand}
+      }};
+      for (const auto& named_op : named_ops) {
+        if (name == named_op.first) {
+          decoded.op = named_op.second;
+          return true;
+        }
+      }
+      // Input-N / Output-N
+      for (const auto& [prefix, op] : {std::pair<std::string, Opcode>{"Input-", Opcode::Input}, {"Output-", Opcode::Output}}) {
+        if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0) continue;
+        const std::string id_str(name.substr(prefix.size()));
+        if (id_str.find_first_not_of("0123456789") != std::string::npos) return false;
+        const size_t pathway_id = std::stoul(id_str);
+        if (pathway_id >= MAX_PATHWAYS) return false;
+        decoded.op = op;
+        decoded.pathway = (uint8_t)pathway_id;
+        return true;
+      }
+      return false;
+    }
+
+  public:
+    OpcodeTable() = default;
+    OpcodeTable(const inst_lib_t& inst_lib) { Build(inst_lib); }
+
+    void Build(const inst_lib_t& inst_lib) {
+      by_inst_id.resize(inst_lib.GetSize());
+      complete = true;
+      for (size_t inst_id = 0; inst_id < by_inst_id.size(); ++inst_id) {
+        complete = DecodeName(inst_lib.GetName(inst_id), by_inst_id[inst_id]) && complete;
+      }
+    }
+
+    bool IsComplete() const { return complete; }
+    size_t GetSize() const { return by_inst_id.size(); }
+    const DecodedInst& Decode(size_t inst_id) const { emp_assert(inst_id < by_inst_id.size()); return by_inst_id[inst_id]; }
+  };
+
+  // --- AvidaGP replicator instructions (shared by instruction libraries and the pre-decoded interpreter) ---
+  static void Inst_Nop(this_t& hw, const inst_t& inst) { ; }
+
+  static void Inst_CopyInst(this_t& hw, const inst_t& inst) {
+    if (hw.IsDoneCopying()) return; // Don't over-copy.
+    hw.IncSitesCopied();            // 'Copy' an instruction.
+  }
+
+  static void Inst_GetLen(this_t& hw, const inst_t& inst) {
+    hw.regs[inst.args[0]] = hw.GetSize();
+  }
+
+  static void Inst_DivideSelf(this_t& hw, const inst_t& inst) {
+    hw.SetDividing(hw.IsDoneCopying());
+    hw.IncFailedSelfDivisions((size_t)!hw.IsDividing());
+  }
+
+  static void Inst_Nand(this_t& hw, const inst_t& inst) {
+    hw.regs[inst.args[2]] = ~((uint32_t)hw.regs[inst.args[0]]&(uint32_t)hw.regs[inst.args[1]]);
+  }
+
+  static void Inst_Input(this_t& hw, const inst_t& inst, size_t pathway_id) {
+    const auto& input_buffer = hw.GetInputBuffer(pathway_id);
+    emp_assert(input_buffer.size(), "Input buffer should contain at least one element", pathway_id, input_buffer.size());
+    const size_t input_ptr = hw.AdvanceInputPointer(pathway_id);    // Returns the current input pointer value and then advances the pointer.
+    emp_assert(input_ptr < input_buffer.size(), input_ptr, input_buffer.size());
+    hw.regs[inst.args[0]] = input_buffer[input_ptr];
+  }
+
+  static void Inst_Output(this_t& hw, const inst_t& inst, size_t pathway_id) {
+    hw.GetOutputBuffer(pathway_id).emplace_back(hw.regs[inst.args[0]]);
+  }
 
 protected:
 
@@ -34,86 +160,149 @@ protected:
   bool dividing=false;           /// Did virtual hardware trigger division (self-replication)?
   size_t failed_self_divisions=0;     /// Number of failed division attempts
 
-  size_t num_pathways=0;
-  emp::vector<size_t> env_ids;
-  emp::vector<size_t> input_pointers;
-  emp::vector< input_buffer_t > input_buffers;
-  emp::vector< output_buffer_t > output_buffers;
+  size_t num_pathways=1;
+  std::array<size_t, MAX_PATHWAYS> env_ids{};
+  std::array<size_t, MAX_PATHWAYS> input_pointers{};
+  std::array<input_buffer_t, MAX_PATHWAYS> input_buffers{};
+  std::array<output_buffer_t, MAX_PATHWAYS> output_buffers{};
+
+  emp::Ptr<const OpcodeTable> opcode_table=nullptr; ///< Used to decode the genome (nullptr: use library dispatch).
+  emp::vector<DecodedInst> decoded_genome;           ///< Genome decoded with opcode_table (empty: needs decoding).
+
+  void DecodeGenome() {
+    const size_t size = this->GetSize();
+    decoded_genome.resize(size);
+    for (size_t i = 0; i < size; ++i) decoded_genome[i] = opcode_table->Decode(this->genome[i].id);
+  }
+
+  /// Pre-decoded equivalent of AvidaCPU_Base::SingleProcess.
+  void DecodedProcess() {
+    emp_assert(this->GetSize() > 0);
+    if (decoded_genome.size() != this->GetSize()) DecodeGenome();
+    if (this->GetIP() >= this->GetSize()) this->ResetIP();
+    const size_t ip = this->GetIP();
+    const inst_t& inst = this->genome[ip];
+    const DecodedInst decoded = decoded_genome[ip];
+    switch (decoded.op) {
+      case Opcode::Nop: break;
+      case Opcode::Inc: inst_lib_t::Inst_Inc(*this, inst); break;
+      case Opcode::Dec: inst_lib_t::Inst_Dec(*this, inst); break;
+      case Opcode::Not: inst_lib_t::Inst_Not(*this, inst); break;
+      case Opcode::SetReg: inst_lib_t::Inst_SetReg(*this, inst); break;
+      case Opcode::Add: inst_lib_t::Inst_Add(*this, inst); break;
+      case Opcode::Sub: inst_lib_t::Inst_Sub(*this, inst); break;
+      case Opcode::Mult: inst_lib_t::Inst_Mult(*this, inst); break;
+      case Opcode::Div: inst_lib_t::Inst_Div(*this, inst); break;
+      case Opcode::Mod: inst_lib_t::Inst_Mod(*this, inst); break;
+      case Opcode::TestEqu: inst_lib_t::Inst_TestEqu(*this, inst); break;
+      case Opcode::TestNEqu: inst_lib_t::Inst_TestNEqu(*this, inst); break;
+      case Opcode::TestLess: inst_lib_t::Inst_TestLess(*this, inst); break;
+      case Opcode::If: inst_lib_t::Inst_If(*this, inst); break;
+      case Opcode::While: inst_lib_t::Inst_While(*this, inst); break;
+      case Opcode::Countdown: inst_lib_t::Inst_Countdown(*this, inst); break;
+      case Opcode::Break: inst_lib_t::Inst_Break(*this, inst); break;
+      case Opcode::Scope: inst_lib_t::Inst_Scope(*this, inst); break;
+      case Opcode::Define: inst_lib_t::Inst_Define(*this, inst); break;
+      case Opcode::Call: inst_lib_t::Inst_Call(*this, inst); break;
+      case Opcode::Push: inst_lib_t::Inst_Push(*this, inst); break;
+      case Opcode::Pop: inst_lib_t::Inst_Pop(*this, inst); break;
+      case Opcode::CopyVal: inst_lib_t::Inst_CopyVal(*this, inst); break;
+      case Opcode::ScopeReg: inst_lib_t::Inst_ScopeReg(*this, inst); break;
+      case Opcode::CopyInst: Inst_CopyInst(*this, inst); break;
+      case Opcode::GetLen: Inst_GetLen(*this, inst); break;
+      case Opcode::DivideSelf: Inst_DivideSelf(*this, inst); break;
+      case Opcode::Nand: Inst_Nand(*this, inst); break;
+      case Opcode::Input: Inst_Input(*this, inst, decoded.pathway); break;
+      case Opcode::Output: Inst_Output(*this, inst, decoded.pathway); break;
+    }
+    this->SetIP(this->GetIP() + 1);
+  }
 
 public:
 
-  AvidaGPReplicator(const genome_t & in_genome) :
-    AvidaCPU_Base(in_genome),
-    num_pathways(1),
-    env_ids(1,0),
-    input_pointers(1,0),
-    input_buffers(1),
-    output_buffers(1)
+  BasicAvidaGPReplicator(const genome_t & in_genome) :
+    base_t(in_genome)
   { ; }
 
-  AvidaGPReplicator(emp::Ptr<const inst_lib_t> inst_lib) :
-    AvidaCPU_Base(genome_t(inst_lib)),
-    num_pathways(1),
-    env_ids(1,0),
-    input_pointers(1,0),
-    input_buffers(1),
-    output_buffers(1)
+  BasicAvidaGPReplicator(emp::Ptr<const inst_lib_t> inst_lib) :
+    base_t(genome_t(inst_lib))
   { ; }
 
-  AvidaGPReplicator(const inst_lib_t & inst_lib) :
-    AvidaCPU_Base(genome_t(&inst_lib)),
-    num_pathways(1),
-    env_ids(1,0),
-    input_pointers(1,0),
-    input_buffers(1),
-    output_buffers(1)
+  BasicAvidaGPReplicator(const inst_lib_t & inst_lib) :
+    base_t(genome_t(&inst_lib))
   { ; }
 
-  AvidaGPReplicator() = default;
-  AvidaGPReplicator(const AvidaGPReplicator &) = default;
-  AvidaGPReplicator(AvidaGPReplicator &&) = default;
+  BasicAvidaGPReplicator() = default;
+  BasicAvidaGPReplicator(const BasicAvidaGPReplicator &) = default;
+  BasicAvidaGPReplicator(BasicAvidaGPReplicator &&) = default;
 
-  virtual ~AvidaGPReplicator() { ; }
+  virtual ~BasicAvidaGPReplicator() { ; }
 
   void ResetReplicatorHardware(size_t n_pathways) {
     SetNumPathways(n_pathways);
     ResetReplicatorHardware();
   }
 
+  /// Reset execution state. Input buffers (views onto the environment) are left in place, but input pointers are rewound.
   void ResetReplicatorHardware() {
     sites_copied=0;
     dividing=false;
     failed_self_divisions=0;
-    for (auto& buffer : input_buffers) {
-      buffer.clear();
+    decoded_genome.clear(); // The genome may have changed (e.g., mutations); decode it again on the next step.
+    for (size_t i = 0; i < num_pathways; ++i) {
+      output_buffers[i].clear();
+      input_pointers[i] = 0;
     }
-    for (auto& buffer : output_buffers) {
-      buffer.clear();
+    this->ResetHardware();
+  }
+
+  /// Load a new genome and reset the hardware as if it were newly constructed.
+  /// NOTE - the number of pathways is kept as-is (tasks configure it when the organism is placed).
+  void Recycle(const genome_t& in_genome) {
+    this->genome = in_genome;
+    world_id=0;
+    env_ids.fill(0);
+    input_buffers.fill(input_buffer_t());
+    opcode_table=nullptr;
+    ResetReplicatorHardware();
+  }
+
+  /// Use the given opcode table (built from this hardware's instruction library) to run pre-decoded programs.
+  /// Incomplete tables (or nullptr) leave the hardware on library dispatch.
+  void SetOpcodeTable(emp::Ptr<const OpcodeTable> table) {
+    emp_assert(!table || table->GetSize() == this->GetInstLib()->GetSize());
+    opcode_table = (table && table->IsComplete()) ? table : nullptr;
+    decoded_genome.clear();
+  }
+
+  bool IsDecoding() const { return (bool)opcode_table; }
+
+  /// Execute the next instruction.
+  void Step() {
+    #ifndef DIRDEVO_AVIDAGP_LIBRARY_INTERPRETER
+    if (opcode_table) {
+      DecodedProcess();
+      return;
     }
-    std::fill(
-      input_pointers.begin(),
-      input_pointers.end(),
-      0
-    );
-    ResetHardware();
+    #endif // DIRDEVO_AVIDAGP_LIBRARY_INTERPRETER
+    this->SingleProcess();
   }
 
   void SetNumPathways(size_t n_pathways) {
     emp_assert(n_pathways > 0, "Cannot set number of pathways to 0.", n_pathways);
+    emp_assert(n_pathways <= MAX_PATHWAYS, "Too many pathways for this hardware (see DIRDEVO_AVIDAGP_MAX_PATHWAYS).", n_pathways, MAX_PATHWAYS);
     num_pathways = n_pathways;
-    env_ids.resize(num_pathways, 0);
-    input_pointers.resize(num_pathways, 0);
-    input_buffers.resize(num_pathways);
-    output_buffers.resize(num_pathways);
   }
 
+  size_t GetNumPathways() const { return num_pathways; }
+
   size_t GetEnvID(size_t buffer_id=0) const {
-    emp_assert(buffer_id < env_ids.size());
+    emp_assert(buffer_id < num_pathways);
     return env_ids[buffer_id];
   }
 
   void SetEnvID(size_t buffer_id, size_t e_id) {
-    emp_assert(buffer_id < env_ids.size());
+    emp_assert(buffer_id < num_pathways);
     env_ids[buffer_id] = e_id;
   }
 
@@ -125,22 +314,32 @@ public:
   size_t GetWorldID() const { return world_id; }
   void SetWorldID(size_t id) { world_id = id; }
 
-  emp::vector<input_t>& GetInputBuffer(size_t buffer_id=0) {
-    emp_assert(buffer_id < input_buffers.size());
+  const input_buffer_t& GetInputBuffer(size_t buffer_id=0) const {
+    emp_assert(buffer_id < num_pathways);
     return input_buffers[buffer_id];
   }
-  emp::vector<output_t>& GetOutputBuffer(size_t buffer_id=0) {
-    emp_assert(buffer_id < output_buffers.size());
+
+  /// Bind a pathway to an environment: record the environment's id, point the pathway's input buffer at the environment's
+  /// inputs (no copy; the environment's inputs are immutable and must outlive this binding), and rewind the input pointer.
+  void BindEnvironment(size_t buffer_id, size_t e_id, input_buffer_t inputs) {
+    emp_assert(buffer_id < num_pathways);
+    emp_assert(inputs.size(), "Environment must have at least one input.");
+    env_ids[buffer_id] = e_id;
+    input_buffers[buffer_id] = inputs;
+    input_pointers[buffer_id] = 0;
+  }
+
+  output_buffer_t& GetOutputBuffer(size_t buffer_id=0) {
+    emp_assert(buffer_id < num_pathways);
     return output_buffers[buffer_id];
   }
   size_t GetInputPointer(size_t buffer_id=0) const {
-    emp_assert(buffer_id < input_pointers.size());
+    emp_assert(buffer_id < num_pathways);
     return input_pointers[buffer_id];
   }
 
   size_t AdvanceInputPointer(size_t buffer_id=0) {
-    emp_assert(buffer_id < input_buffers.size());
-    emp_assert(buffer_id < input_pointers.size());
+    emp_assert(buffer_id < num_pathways);
     const size_t ret_val=input_pointers[buffer_id];
     input_pointers[buffer_id] = (ret_val+1) % input_buffers[buffer_id].size();
     return ret_val;
@@ -152,13 +351,56 @@ public:
   size_t GetNumFailedSelfDivisions() const { return failed_self_divisions; }
   void IncFailedSelfDivisions(size_t inc=1) { failed_self_divisions += inc; }
 
-  bool IsDoneCopying() const { return sites_copied >= GetSize(); }
+  bool IsDoneCopying() const { return sites_copied >= this->GetSize(); }
   size_t GetSitesCopied() const { return sites_copied; }
   void SetSitesCopied(size_t copied) { sites_copied = copied; }
   void IncSitesCopied(size_t inc=1) { sites_copied += inc; }
 
 };
 
+using AvidaGPReplicator = BasicAvidaGPReplicator<DIRDEVO_AVIDAGP_MAX_PATHWAYS, 4>;
+
+/// Hash AvidaGP genomes by their instruction ids and arguments (emp::Genome has no std::hash specialization).
+template<>
+struct GenomeHasher<AvidaGPReplicator::genome_t> {
+  uint64_t operator()(const AvidaGPReplicator::genome_t& genome) const {
+    uint64_t hash = MixHash64(genome.GetSize());
+    for (size_t i = 0; i < genome.GetSize(); ++i) {
+      const auto& inst = genome[i];
+      hash = CombineHash64(hash, inst.id);
+      for (size_t arg : inst.args) {
+        hash = CombineHash64(hash, arg);
+      }
+    }
+    return hash;
+  }
+};
+
+/// AvidaGP genome fields (for mutation deltas): instruction i's id is site i * (1 + INST_ARGS), and its arguments are
+/// the INST_ARGS sites after that.
+template<>
+struct GenomeFields<AvidaGPReplicator::genome_t> {
+  static constexpr size_t INST_ARGS = AvidaGPReplicator::hardware_t::INST_ARGS;
+  static constexpr size_t FIELDS_PER_INST = 1 + INST_ARGS;
+
+  static size_t IdSite(size_t inst_i) { return inst_i * FIELDS_PER_INST; }
+  static size_t ArgSite(size_t inst_i, size_t arg_i) { return inst_i * FIELDS_PER_INST + 1 + arg_i; }
+  static size_t GetNumSites(const AvidaGPReplicator::genome_t& genome) { return genome.GetSize() * FIELDS_PER_INST; }
+
+  static uint32_t Get(const AvidaGPReplicator::genome_t& genome, size_t site) {
+    const auto& inst = genome[site / FIELDS_PER_INST];
+    const size_t field = site % FIELDS_PER_INST;
+    return (uint32_t)(field ? inst.args[field - 1] : inst.id);
+  }
+
+  static void Set(AvidaGPReplicator::genome_t& genome, size_t site, uint32_t value) {
+    auto& inst = genome[site / FIELDS_PER_INST];
+    const size_t field = site % FIELDS_PER_INST;
+    if (field) inst.args[field - 1] = value;
+    else inst.id = value;
+  }
+};
+
 }
 
 #endif // #ifndef
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "../../utility/TaskSet.hpp"
 #include "../../utility/boolean_logic_impls.hpp"
 #include "../../utility/math_task_impls.hpp"
+#include "../../utility/batch_task_kernels.hpp"
 
 namespace dirdevo {
 
@@ -23,15 +24,63 @@ protected:
 
   struct AGP_TaskSpec {
     using calc_fun_t = std::function<output_t(const emp::vector<input_t>&)>;
+    using batch_fun_t = std::function<void(const input_t* const*, output_t*, size_t)>;
     std::string name;
     calc_fun_t calc;
     size_t num_inputs;
     std::string desc;
-    AGP_TaskSpec(const std::string& a_name, const calc_fun_t& a_calc, size_t a_num_inputs, const std::string& a_desc) :
-      name(a_name), calc(a_calc), num_inputs(a_num_inputs), desc(a_desc)
+    batch_fun_t batch;
+    AGP_TaskSpec(const std::string& a_name, const calc_fun_t& a_calc, size_t a_num_inputs, const std::string& a_desc, const batch_fun_t& a_batch) :
+      name(a_name), calc(a_calc), num_inputs(a_num_inputs), desc(a_desc), batch(a_batch)
     {}
   };
 
+  // Each pre-defined task is specified by a single scalar op, which is used for both its calc_output_fun and its (batch)
+  // calc_batch_fun. (Pass ops as lambdas so they inline into the batch kernels.)
+  template<typename OP_T>
+  static AGP_TaskSpec LogicTask1(const std::string& name, OP_T op, const std::string& desc) {
+    return {
+      name,
+      [op](const emp::vector<input_t>& inputs) { emp_assert(inputs.size() >= 1); return (output_t)op((uint32_t)inputs[0]); },
+      1,
+      desc,
+      [op](const input_t* const* inputs, output_t* outputs, size_t count) { batch::ApplyLogic1(op, inputs[0], outputs, count); }
+    };
+  }
+
+  template<typename OP_T>
+  static AGP_TaskSpec LogicTask2(const std::string& name, OP_T op, const std::string& desc) {
+    return {
+      name,
+      [op](const emp::vector<input_t>& inputs) { emp_assert(inputs.size() >= 2); return (output_t)op((uint32_t)inputs[0], (uint32_t)inputs[1]); },
+      2,
+      desc,
+      [op](const input_t* const* inputs, output_t* outputs, size_t count) { batch::ApplyLogic2(op, inputs[0], inputs[1], outputs, count); }
+    };
+  }
+
+  template<typename OP_T>
+  static AGP_TaskSpec MathTask1(const std::string& name, OP_T op, const std::string& desc) {
+    return {
+      name,
+      [op](const emp::vector<input_t>& inputs) { emp_assert(inputs.size() >= 1); return (output_t)op(inputs[0]); },
+      1,
+      desc,
+      [op](const input_t* const* inputs, output_t* outputs, size_t count) { batch::Apply1(op, inputs[0], outputs, count); }
+    };
+  }
+
+  template<typename OP_T>
+  static AGP_TaskSpec MathTask2(const std::string& name, OP_T op, const std::string& desc) {
+    return {
+      name,
+      [op](const emp::vector<input_t>& inputs) { emp_assert(inputs.size() >= 2); return (output_t)op(inputs[0], inputs[1]); },
+      2,
+      desc,
+      [op](const input_t* const* inputs, output_t* outputs, size_t count) { batch::Apply2(op, inputs[0], inputs[1], outputs, count); }
+    };
+  }
+
   static const std::map<std::string,AGP_TaskSpec> valid_tasks;
 
 public:
@@ -46,7 +95,8 @@ public:
           task_spec.name,
           task_spec.calc,
           task_spec.num_inputs,
-          task_spec.desc
+          task_spec.desc,
+          task_spec.batch
         );
       } else {
         unused_names.emplace_back(name);
@@ -60,206 +110,31 @@ public:
 /// Valid tasks for the avidagp task set
 const std::map<std::string,AvidaGPTaskSet::AGP_TaskSpec> AvidaGPTaskSet::valid_tasks={
   //============================== BOOLEAN LOGIC TASKS ==============================
-  {
-    "ECHO",
-    {
-      "ECHO",
-       [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { emp_assert(inputs.size() >= 1); return logic::ECHO((uint32_t)inputs[0]); },
-       1,
-       "ECHO function"
-    }
-  },
-
-  {
-    "NAND",
-    {
-      "NAND",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { emp_assert(inputs.size() >= 2); return logic::NAND((uint32_t)inputs[0], (uint32_t)inputs[1]); },
-      2,
-      "NAND boolean logic function"
-    }
-  },
-
-  {
-    "NOT",
-    {
-      "NOT",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { emp_assert(inputs.size() >= 1); return logic::NOT((uint32_t)inputs[0]); },
-      1,
-      "NOT boolean logic function"
-    }
-  },
-
-  {
-    "OR_NOT",
-    {
-      "OR_NOT",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { emp_assert(inputs.size() >= 2); return logic::OR_NOT((uint32_t)inputs[0], (uint32_t)inputs[1]); },
-      2,
-      "OR_NOT boolean logic function"
-    }
-  },
-
-  {
-    "AND",
-    {
-      "AND",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { emp_assert(inputs.size() >= 2); return logic::AND((uint32_t)inputs[0], (uint32_t)inputs[1]); },
-      2,
-      "AND boolean logic function"
-    }
-  },
-
-  {
-    "OR",
-    {
-      "OR",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { emp_assert(inputs.size() >= 2); return logic::OR((uint32_t)inputs[0], (uint32_t)inputs[1]); },
-      2,
-      "OR boolean logic function"
-    }
-  },
-
-  {
-    "AND_NOT",
-    {
-      "AND_NOT",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { emp_assert(inputs.size() >= 2); return logic::AND_NOT((uint32_t)inputs[0], (uint32_t)inputs[1]); },
-      2,
-      "AND_NOT boolean logic function"
-    }
-  },
-
-  {
-    "NOR",
-    {
-      "NOR",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { emp_assert(inputs.size() >= 2); return logic::NOR((uint32_t)inputs[0], (uint32_t)inputs[1]); },
-      2,
-      "NOR boolean logic function"
-    }
-  },
-
-  {
-    "XOR",
-    {
-      "XOR",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { emp_assert(inputs.size() >= 2); return logic::XOR((uint32_t)inputs[0], (uint32_t)inputs[1]); },
-      2,
-      "XOR boolean logic function"
-    }
-  },
-
-  {
-    "EQU",
-    {
-      "EQU",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { emp_assert(inputs.size() >= 2); return logic::EQU((uint32_t)inputs[0], (uint32_t)inputs[1]); },
-      2,
-      "EQU boolean logic function"
-    }
-  },
+  {"ECHO", LogicTask1("ECHO", [](uint32_t a) { return logic::ECHO(a); }, "ECHO function")},
+  {"NAND", LogicTask2("NAND", [](uint32_t a, uint32_t b) { return logic::NAND(a, b); }, "NAND boolean logic function")},
+  {"NOT", LogicTask1("NOT", [](uint32_t a) { return logic::NOT(a); }, "NOT boolean logic function")},
+  {"OR_NOT", LogicTask2("OR_NOT", [](uint32_t a, uint32_t b) { return logic::OR_NOT(a, b); }, "OR_NOT boolean logic function")},
+  {"AND", LogicTask2("AND", [](uint32_t a, uint32_t b) { return logic::AND(a, b); }, "AND boolean logic function")},
+  {"OR", LogicTask2("OR", [](uint32_t a, uint32_t b) { return logic::OR(a, b); }, "OR boolean logic function")},
+  {"AND_NOT", LogicTask2("AND_NOT", [](uint32_t a, uint32_t b) { return logic::AND_NOT(a, b); }, "AND_NOT boolean logic function")},
+  {"NOR", LogicTask2("NOR", [](uint32_t a, uint32_t b) { return logic::NOR(a, b); }, "NOR boolean logic function")},
+  {"XOR", LogicTask2("XOR", [](uint32_t a, uint32_t b) { return logic::XOR(a, b); }, "XOR boolean logic function")},
+  {"EQU", LogicTask2("EQU", [](uint32_t a, uint32_t b) { return logic::EQU(a, b); }, "EQU boolean logic function")},
 
   //============================== 1-INPUT MATH TASKS ==============================
-  {
-    "MATH_1AA",
-    {
-      "MATH_1AA",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { return MATH_1IN::AA(inputs[0]); },
-      1,
-      "1AA"
-    }
-  },
-  {
-    "MATH_1AB",
-    {
-      "MATH_1AB",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { return MATH_1IN::AB(inputs[0]); },
-      1,
-      "1AB"
-    }
-  },
-  {
-    "MATH_1AC",
-    {
-      "MATH_1AC",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { return MATH_1IN::AC(inputs[0]); },
-      1,
-      "1AC"
-    }
-  },
-  {
-    "MATH_2AA",
-    {
-      "MATH_2AA",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { return MATH_2IN::AA(inputs[0], inputs[1]); },
-      2,
-      "2AA"
-    }
-  },
-  {
-    "MATH_2AB",
-    {
-      "MATH_2AB",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { return MATH_2IN::AB(inputs[0], inputs[1]); },
-      2,
-      "2AB"
-    }
-  },
-  {
-    "MATH_2AC",
-    {
-      "MATH_2AC",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { return MATH_2IN::AC(inputs[0], inputs[1]); },
-      2,
-      "2AC"
-    }
-  },
-  {
-    "MATH_2AD",
-    {
-      "MATH_2AD",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { return MATH_2IN::AD(inputs[0], inputs[1]); },
-      2,
-      "2AD"
-    }
-  },
-  {
-    "MATH_2AE",
-    {
-      "MATH_2AE",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { return MATH_2IN::AE(inputs[0], inputs[1]); },
-      2,
-      "2AE"
-    }
-  },
-  {
-    "MATH_2AF",
-    {
-      "MATH_2AF",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { return MATH_2IN::AF(inputs[0], inputs[1]); },
-      2,
-      "2AF"
-    }
-  },
-  {
-    "MATH_2AG",
-    {
-      "MATH_2AG",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { return MATH_2IN::AG(inputs[0], inputs[1]); },
-      2,
-      "2AG"
-    }
-  },
-  {
-    "MATH_2AH",
-    {
-      "MATH_2AH",
-      [](const emp::vector<AvidaGPTaskSet::input_t>& inputs) { return MATH_2IN::AH(inputs[0], inputs[1]); },
-      2,
-      "2AH"
-    }
-  }
+  {"MATH_1AA", MathTask1("MATH_1AA", [](AvidaGPTaskSet::input_t a) { return MATH_1IN::AA(a); }, "1AA")},
+  {"MATH_1AB", MathTask1("MATH_1AB", [](AvidaGPTaskSet::input_t a) { return MATH_1IN::AB(a); }, "1AB")},
+  {"MATH_1AC", MathTask1("MATH_1AC", [](AvidaGPTaskSet::input_t a) { return MATH_1IN::AC(a); }, "1AC")},
+
+  //============================== 2-INPUT MATH TASKS ==============================
+  {"MATH_2AA", MathTask2("MATH_2AA", [](AvidaGPTaskSet::input_t a, AvidaGPTaskSet::input_t b) { return MATH_2IN::AA(a, b); }, "2AA")},
+  {"MATH_2AB", MathTask2("MATH_2AB", [](AvidaGPTaskSet::input_t a, AvidaGPTaskSet::input_t b) { return MATH_2IN::AB(a, b); }, "2AB")},
+  {"MATH_2AC", MathTask2("MATH_2AC", [](AvidaGPTaskSet::input_t a, AvidaGPTaskSet::input_t b) { return MATH_2IN::AC(a, b); }, "2AC")},
+  {"MATH_2AD", MathTask2("MATH_2AD", [](AvidaGPTaskSet::input_t a, AvidaGPTaskSet::input_t b) { return MATH_2IN::AD(a, b); }, "2AD")},
+  {"MATH_2AE", MathTask2("MATH_2AE", [](AvidaGPTaskSet::input_t a, AvidaGPTaskSet::input_t b) { return MATH_2IN::AE(a, b); }, "2AE")},
+  {"MATH_2AF", MathTask2("MATH_2AF", [](AvidaGPTaskSet::input_t a, AvidaGPTaskSet::input_t b) { return MATH_2IN::AF(a, b); }, "2AF")},
+  {"MATH_2AG", MathTask2("MATH_2AG", [](AvidaGPTaskSet::input_t a, AvidaGPTaskSet::input_t b) { return MATH_2IN::AG(a, b); }, "2AG")},
+  {"MATH_2AH", MathTask2("MATH_2AH", [](AvidaGPTaskSet::input_t a, AvidaGPTaskSet::input_t b) { return MATH_2IN::AH(a, b); }, "2AH")}
 
 };
 
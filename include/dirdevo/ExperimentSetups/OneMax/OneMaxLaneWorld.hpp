@@ -0,0 +1,275 @@
+#pragma once
+#ifndef DIRECTED_DEVO_DIRECTED_DEVO_ONEMAX_LANE_WORLD_HPP_INCLUDE
+#define DIRECTED_DEVO_DIRECTED_DEVO_ONEMAX_LANE_WORLD_HPP_INCLUDE
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/bits/BitSet.hpp"
+#include "emp/math/math.hpp"
+#include "emp/math/Random.hpp"
+
+#include "../../DirectedDevoConfig.hpp"
+#include "../../mutator/BitSetMutator.hpp"
+#include "OneMaxOrganism.hpp"
+
+namespace dirdevo {
+
+/// Step count lanes (organisms) of OneMaxOrganism state forward, where lane i takes steps[i] steps.
+/// This is the closed form of steps[i] calls to OneMaxOrganism::ProcessStep, each followed by the world's birth check
+/// (a parent's resources reset to zero when it reproduces): births[i] is how many offspring lane i produced.
+/// Requires resources below the reproduction threshold (as they are between calls) and steps below 2^31.
+/// Values are integers stored as doubles; quotients are truncated through int32_t (rather than std::floor/std::ceil,
+/// and with no comparisons on doubles), so the loop auto-vectorizes at -O3 under default floating point flags (see
+/// utility/batch_task_kernels.hpp).
+template<size_t BITS>
+void StepOneMaxLanes(
+  const double* __restrict steps,
+  const double* __restrict num_ones,
+  double* __restrict resources,
+  double* __restrict age,
+  double* __restrict births,
+  size_t count
+) {
+  constexpr double threshold = OneMaxOrganism<BITS>::REPRO_RES_THRESHOLD;
+  for (size_t i = 0; i < count; ++i) {
+    const double gain = 1 + num_ones[i];                                                // Resources collected per step
+    const double first = (double)(int32_t)((threshold - resources[i] + gain - 1) / gain); // Steps until first reproduction
+    const double period = (double)(int32_t)((threshold + gain - 1) / gain);             // Steps between later reproductions
+    const double after = steps[i] - first;                                              // >= -period (first <= period)
+    const int32_t num_births = (int32_t)((after + period) / period);                    // floor(after / period) + 1, or 0
+    const double reproduced = (double)std::min(num_births, 1);
+    births[i] = (double)num_births;
+    resources[i] = reproduced * (after - (num_births - 1) * period) * gain
+                 + (1 - reproduced) * (resources[i] + steps[i] * gain);
+    age[i] += steps[i];
+  }
+}
+
+/// OneMaxLaneWorld is a structure-of-arrays population of OneMaxOrganisms: a fast, synthetic workload for stress-testing
+/// population-level selection and propagule sampling with millions of organisms.
+/// - Per-organism state (num_ones, resources, age) lives in contiguous arrays; living organisms occupy lanes
+///   [0, GetNumOrgs()) in no particular order.
+/// - Each update, organisms get steps in proportion to merit (as in DirectedDevoWorld's scheduler, but drawn for the
+///   whole update at once), and every lane's steps are applied in one batch (StepOneMaxLanes).
+/// - Births and deaths are resolved at the end of the update: dead organisms are compacted out, and offspring are placed
+///   as in a well-mixed world: each offspring goes to a uniformly random cell in [0, capacity), replacing its occupant
+///   or filling an empty cell. Placements are drawn first, so only offspring that aren't overwritten by a later
+///   offspring in the same update are actually built (copied and mutated with a BitSetMutator).
+/// Differences from DirectedDevoWorld<OneMaxOrganism, OneMaxTask>: organisms born during an update don't step until
+/// the next update, and an organism that dies of old age can still reproduce during the update in which it dies.
+template<size_t BITS=128>
+class OneMaxLaneWorld {
+public:
+  using org_t = OneMaxOrganism<BITS>;
+  using genome_t = typename org_t::genome_t;
+  using mutator_t = BitSetMutator;
+  using config_t = DirectedDevoConfig;
+
+  static constexpr size_t GENOME_SIZE = BITS;
+
+protected:
+  static constexpr size_t NO_PARENT = (size_t)-1;
+
+  const config_t& config;
+  emp::Random& random;
+  mutator_t mutator;
+
+  size_t capacity=0;       ///< Maximum number of organisms (i.e., the number of cells in an equivalent world)
+  size_t num_orgs=0;
+  size_t update=0;
+  size_t avg_org_steps_per_update=1;
+
+  // Per-organism state (lanes [0, num_orgs) are alive)
+  emp::vector<genome_t> genomes;
+  emp::vector<double> num_ones;
+  emp::vector<double> resources;
+  emp::vector<double> ages;
+
+  // Per-update scratch (reused across updates)
+  emp::vector<double> steps;
+  emp::vector<double> births;
+  emp::vector<uint8_t> dead;
+  emp::vector<size_t> offspring_parents; ///< Parent lane of the last offspring placed in each target lane
+  emp::vector<size_t> offspring_targets; ///< Lanes (after compaction) that receive offspring, in first-placement order
+  emp::vector<genome_t> offspring;       ///< Offspring genome for each target lane
+
+  // Stats
+  size_t total_births=0;
+  size_t total_deaths=0;
+
+  // Evaluation (see Evaluate)
+  double average_num_ones=0;
+  emp::vector<double> ones_per_position;
+
+  static double CalcMerit(double ones) { return 1 + emp::Pow2(ones); } // Same as OneMaxOrganism::UpdateMerit
+
+  /// Put an organism into lane id (id == num_orgs appends a lane).
+  void SetLane(size_t id, const genome_t& genome) {
+    emp_assert(id <= num_orgs && id < capacity, id, num_orgs, capacity);
+    genomes[id] = genome;
+    num_ones[id] = (double)genome.CountOnes();
+    resources[id] = 0;
+    ages[id] = 0;
+    if (id == num_orgs) ++num_orgs;
+  }
+
+  void MoveLane(size_t from, size_t to) {
+    genomes[to] = genomes[from];
+    num_ones[to] = num_ones[from];
+    resources[to] = resources[from];
+    ages[to] = ages[from];
+  }
+
+  /// Place an organism as a well-mixed world would: in a random cell, replacing whoever is there.
+  void Place(const genome_t& genome) {
+    const size_t cell = random.GetUInt(capacity);
+    SetLane(std::min(cell, num_orgs), genome);
+  }
+
+  /// Draw each organism's steps for this update (in proportion to merit; fractional steps are rounded randomly).
+  void ScheduleSteps() {
+    double total_merit = 0;
+    for (size_t i = 0; i < num_orgs; ++i) {
+      steps[i] = CalcMerit(num_ones[i]);
+      total_merit += steps[i];
+    }
+    const double steps_per_merit = (double)(num_orgs * avg_org_steps_per_update) / total_merit;
+    for (size_t i = 0; i < num_orgs; ++i) {
+      steps[i] = std::floor(steps[i] * steps_per_merit + random.GetDouble());
+    }
+  }
+
+  /// Decide which organisms died of old age this update: like OneMaxOrganism::ProcessStep, each step taken at or past
+  /// MAX_AGE is a 50% chance to die.
+  void ResolveDeaths() {
+    constexpr double max_age = (double)org_t::MAX_AGE;
+    for (size_t i = 0; i < num_orgs; ++i) {
+      dead[i] = 0;
+      const double old_steps = std::min(steps[i], ages[i] - max_age + 1);
+      if (old_steps > 0) dead[i] = random.P(1.0 - std::pow(0.5, old_steps));
+    }
+  }
+
+  /// Decide where this update's offspring go (lane ids after compaction) and build the offspring that end up in each
+  /// lane (before any parent is removed).
+  void StageOffspring() {
+    offspring_targets.clear();
+    offspring.clear();
+    size_t lanes_used = num_orgs - (size_t)std::count(dead.begin(), dead.begin() + num_orgs, (uint8_t)1);
+    for (size_t i = 0; i < num_orgs; ++i) {
+      const size_t num_births = (size_t)births[i];
+      total_births += num_births;
+      for (size_t b = 0; b < num_births; ++b) {
+        const size_t target = std::min((size_t)random.GetUInt(capacity), lanes_used);
+        if (target == lanes_used) ++lanes_used;
+        if (offspring_parents[target] == NO_PARENT) offspring_targets.emplace_back(target);
+        offspring_parents[target] = i;
+      }
+    }
+    for (size_t target : offspring_targets) {
+      offspring.emplace_back(genomes[offspring_parents[target]]);
+      mutator.Mutate(offspring.back(), random);
+      offspring_parents[target] = NO_PARENT;
+    }
+  }
+
+  /// Remove dead organisms, packing the living into lanes [0, num_orgs).
+  void Compact() {
+    size_t living = 0;
+    for (size_t i = 0; i < num_orgs; ++i) {
+      if (dead[i]) continue;
+      if (living != i) MoveLane(i, living);
+      ++living;
+    }
+    total_deaths += num_orgs - living;
+    num_orgs = living;
+  }
+
+public:
+  OneMaxLaneWorld(const config_t& cfg, emp::Random& rnd, size_t world_capacity) :
+    config(cfg),
+    random(rnd),
+    capacity(world_capacity),
+    avg_org_steps_per_update(cfg.AVG_STEPS_PER_ORG()),
+    genomes(world_capacity),
+    num_ones(world_capacity, 0),
+    resources(world_capacity, 0),
+    ages(world_capacity, 0),
+    steps(world_capacity, 0),
+    births(world_capacity, 0),
+    dead(world_capacity, 0),
+    offspring_parents(world_capacity, NO_PARENT),
+    ones_per_position(GENOME_SIZE, 0)
+  {
+    emp_assert(capacity > 0);
+    emp_assert(avg_org_steps_per_update > 0);
+    mutator_t::Configure(mutator, config);
+  }
+
+  size_t GetCapacity() const { return capacity; }
+  size_t GetNumOrgs() const { return num_orgs; }
+  size_t GetUpdate() const { return update; }
+  bool IsExtinct() const { return !num_orgs; }
+  size_t GetTotalBirths() const { return total_births; }
+  size_t GetTotalDeaths() const { return total_deaths; }
+
+  const genome_t& GetGenome(size_t id) const { emp_assert(id < num_orgs); return genomes[id]; }
+  size_t GetNumOnes(size_t id) const { emp_assert(id < num_orgs); return (size_t)num_ones[id]; }
+  double GetResources(size_t id) const { emp_assert(id < num_orgs); return resources[id]; }
+  size_t GetAge(size_t id) const { emp_assert(id < num_orgs); return (size_t)ages[id]; }
+  double GetMerit(size_t id) const { emp_assert(id < num_orgs); return CalcMerit(num_ones[id]); }
+
+  /// Id of a uniformly random living organism (e.g., for sampling propagules).
+  size_t GetRandomOrgID() {
+    emp_assert(num_orgs > 0);
+    return random.GetUInt(num_orgs);
+  }
+
+  /// Inject a genome into a random cell (as with births, replacing whoever is there).
+  void Inject(const genome_t& genome) { Place(genome); }
+
+  /// Remove every organism.
+  void Clear() {
+    num_orgs = 0;
+    update = 0;
+  }
+
+  /// Run one world update.
+  void RunStep() {
+    if (IsExtinct()) return;
+    emp_assert(num_orgs * avg_org_steps_per_update < ((size_t)1 << 31), "StepOneMaxLanes requires fewer than 2^31 steps per lane.");
+    ScheduleSteps();
+    StepOneMaxLanes<BITS>(steps.data(), num_ones.data(), resources.data(), ages.data(), births.data(), num_orgs);
+    ResolveDeaths();
+    StageOffspring();
+    Compact();
+    for (size_t i = 0; i < offspring.size(); ++i) SetLane(offspring_targets[i], offspring[i]);
+    ++update;
+  }
+
+  /// Same measures as OneMaxTask::Evaluate: average number of ones, and number of ones at each genome site.
+  void Evaluate() {
+    std::fill(ones_per_position.begin(), ones_per_position.end(), 0.0);
+    double total_ones = 0;
+    for (size_t i = 0; i < num_orgs; ++i) {
+      total_ones += num_ones[i];
+      for (size_t site_i = 0; site_i < GENOME_SIZE; ++site_i) {
+        ones_per_position[site_i] += (double)genomes[i].Get(site_i);
+      }
+    }
+    average_num_ones = (num_orgs) ? total_ones / num_orgs : 0;
+  }
+
+  double GetAverageNumOnes() const { return average_num_ones; }
+  const emp::vector<double>& GetOnesPerPosition() const { return ones_per_position; }
+
+};
+
+} // namespace dirdevo
+
+#endif // #ifndef DIRECTED_DEVO_DIRECTED_DEVO_ONEMAX_LANE_WORLD_HPP_INCLUDE
@@ -19,8 +19,8 @@ public:
   using base_t::SetReproReady;
   using base_t::SetDead;
 
-  const double REPRO_RES_THRESHOLD=1024;
-  const size_t MAX_AGE=2048;
+  static constexpr double REPRO_RES_THRESHOLD=1024;
+  static constexpr size_t MAX_AGE=2048;
 
   struct Phenotype {
     size_t num_ones=0;
@@ -66,12 +66,7 @@ public:
   phenotype_t & GetPhenotype() { return phenotype; }
   const phenotype_t & GetPhenotype() const { return phenotype; }
 
-  // TODO - figure out way to automatically strip out unimplemented organism function calls from world/experiment
-  void OnInjectReady() override { }
-
-  void OnBeforeRepro() override { }
-
-  void OnOffspringReady(this_t & offspring) override {
+  void OnOffspringReady(this_t & offspring) {
     // Reset this organism after dividing.
     resources = 0;
     repro_count += 1;
@@ -80,17 +75,15 @@ public:
   // Called when *this* organism is born
   // - when offspringready signal is triggered
   // - after mutations
-  void OnBirth(this_t & parent) override {
+  void OnBirth(this_t & parent) {
     phenotype.num_ones = genome.CountOnes();
     this->SetDead(false);
     this->SetReproReady(false);
     this->SetNewBorn(true);
   }
 
-  void OnDeath(size_t) override { }
-
   /// Called when *this* organism is placed
-  void OnPlacement(size_t pos) override {
+  void OnPlacement(size_t pos) {
     this->SetWorldID(pos);
     UpdateMerit();
   }
@@ -39,7 +39,7 @@ public:
   // --- WORLD-LEVEL EVENT HOOKS ---
 
   /// OnWorldSetup called at end of constructor/world setup
-  void OnWorldSetup() override {
+  void OnWorldSetup() {
     // TODO - configure task based on world's configuration
 
     // Wire up the aggregate task performance function
@@ -60,15 +60,15 @@ public:
   }
 
   /// OnBeforeWorldUpdate is called at the beginning of running the world update
-  void OnBeforeWorldUpdate(size_t update) override {
+  void OnBeforeWorldUpdate(size_t update) {
     // as soon as the world has updated, evaluation is no longer guaranteed to be fresh
     fresh_eval=false;
   }
 
   /// OnWorldUpdate is called when the OnUpdate signal is triggered (at the end of a world update)
-  void OnWorldUpdate(size_t update) override { /*todo*/ }
+  void OnWorldUpdate(size_t update) { /*todo*/ }
 
-  void OnWorldReset() override {
+  void OnWorldReset() {
     total_num_ones = 0.0;
     std::fill(
       ones_per_position.begin(),
@@ -80,7 +80,7 @@ public:
   // TODO - any selection based hooks!
 
   /// Evaluate the world on this task (count ones).
-  void Evaluate() override {
+  void Evaluate() {
 
     // Reset internal performance state
     total_num_ones = 0.0;
@@ -106,31 +106,7 @@ public:
   }
 
   // --- ORGANISM-LEVEL EVENT HOOKS ---
-  // These are always called AFTER the organism's equivalent functions.
-
-  void OnOrgInjectReady(org_t& org) override { }
-
-  /// Called when parent is about to reproduce, but before an offspring has been constructed.
-  void OnBeforeOrgRepro(org_t & parent) override { /*todo*/ }
-
-  /// Called when the offspring has been constructed but has not been placed yet.
-  void OnOffspringReady(org_t& offspring, org_t& parent) override { /*todo*/ }
-
-  /// Called when org is being placed (@ position) in the world
-  void OnOrgPlacement(org_t& org, size_t position) override { /*todo*/ }
-
-  /// Called just before the organism's process step function is called.
-  void BeforeOrgProcessStep(org_t& org) override { /*todo*/ }
-
-  /// Called just after the organism's process step function is called.
-  void AfterOrgProcessStep(org_t& org) override { /*todo*/ }
-
-  /// Called before organism is removed from the world.
-  void OnOrgDeath(org_t& org, size_t position) override { /*todo*/ }
-
-  /// Called after two organisms are swapped in the world (new world positions are accurate).
-  void AfterOrgSwap(org_t& org1, org_t& org2) override { /*todo*/ }
-
+  // OneMax doesn't need any organism-level hooks; BaseTask's no-op defaults are compiled out of the world.
 
 };
 
@@ -43,20 +43,20 @@ public:
 
   }
 
-  void OnBeforeRepro() override;
+  void OnBeforeRepro();
 
-  void OnOffspringReady(this_t& offspring) override;
+  void OnOffspringReady(this_t& offspring);
 
-  void OnPlacement(size_t position) override;
+  void OnPlacement(size_t position);
 
-  void OnBirth(this_t& parent) override {
+  void OnBirth(this_t& parent) {
     // After mutations have occurred, but before parent & task have been alerted to ready-ness.
     // Safe to spin up the CPU with the current program at this point.
     cpu.InitializeAnchors(genome);
     //
   }
 
-  void OnDeath(size_t position) override;
+  void OnDeath(size_t position);
 
   template<typename WORLD_T>
   void ProcessStep(WORLD_T& world) {
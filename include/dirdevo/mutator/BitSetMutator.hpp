@@ -10,6 +10,8 @@
 #include "emp/math/Random.hpp"
 #include "emp/tools/string_utils.hpp"
 
+#include "GeometricSkip.hpp"
+
 namespace dirdevo {
 
 /// A minimal BitSet Mutator
@@ -20,7 +22,7 @@ public:
   /// Describes the configuration
   struct MutatorConfig {
     double PER_SITE_SUBSTITUTION_RATE=0.0; /// Per-bit bitflip rate
-
+    MutationSampling SAMPLING=MutationSampling::PER_SITE; /// How are bits to flip chosen?
   };
 
   using mut_config_t = MutatorConfig;
@@ -32,6 +34,10 @@ public:
     const std::string per_site_substitution_name(mutator.config_prepend+"_"+"PER_SITE_SUBSTITUTION_RATE");
     emp_assert(exp_config.Has(per_site_substitution_name), "Failed to find parameter ", per_site_substitution_name, " in experiment configuration.");
     mutator.config.PER_SITE_SUBSTITUTION_RATE = emp::from_string<double>(exp_config[per_site_substitution_name]->GetValue());
+    if (exp_config.Has("MUTATION_SAMPLING")) {
+      mutator.config.SAMPLING = ParseMutationSampling(exp_config["MUTATION_SAMPLING"]->GetValue());
+    }
+    mutator.substitution_skip.SetRate(mutator.config.PER_SITE_SUBSTITUTION_RATE);
 
     std::cout << "per site sub: " << mutator.config.PER_SITE_SUBSTITUTION_RATE << std::endl;
   }
@@ -40,6 +46,7 @@ protected:
 
   mut_config_t config;
   std::string config_prepend;
+  GeometricSkip substitution_skip;
 
 public:
   BitSetMutator()
@@ -50,6 +57,13 @@ public:
   template<size_t LEN>
   size_t Mutate(emp::BitSet<LEN>& bits, emp::Random& random) {
     size_t flips = 0;
+    if (config.SAMPLING == MutationSampling::SKIP) {
+      substitution_skip.ForEachHit(LEN, random, [&bits, &flips](size_t i) {
+        bits.Toggle(i);
+        ++flips;
+      });
+      return flips;
+    }
     for (size_t i = 0; i < LEN; ++i) {
       if (random.P(config.PER_SITE_SUBSTITUTION_RATE)) {
         bits.Toggle(i);
@@ -0,0 +1,72 @@
+#pragma once
+#ifndef DIRECTED_DEVO_DIRECTED_DEVO_GEOMETRIC_SKIP_HPP_INCLUDE
+#define DIRECTED_DEVO_DIRECTED_DEVO_GEOMETRIC_SKIP_HPP_INCLUDE
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "emp/math/Random.hpp"
+
+namespace dirdevo {
+
+/// How mutators decide which sites mutate.
+/// - PER_SITE: one random draw per site.
+/// - SKIP: draw the gap to the next mutated site from a geometric distribution (see GeometricSkip).
+/// Both give every site the same, independent chance to mutate; SKIP just needs far fewer draws at low rates.
+/// PER_SITE is the default everywhere (it makes the same random draws as mutators always have, so seeded runs reproduce);
+/// SKIP is opt-in (MUTATION_SAMPLING=skip).
+enum class MutationSampling { PER_SITE, SKIP };
+
+/// Parse a MUTATION_SAMPLING config value ("per-site" or "skip"). Unknown values are fatal.
+inline MutationSampling ParseMutationSampling(const std::string& name) {
+  if (name == "per-site") return MutationSampling::PER_SITE;
+  if (name == "skip") return MutationSampling::SKIP;
+  std::cout << "Unknown mutation sampling method: " << name << std::endl;
+  std::exit(EXIT_FAILURE);
+}
+
+/// GeometricSkip visits the sites of a sequence that get 'hit' when each site is hit independently with probability
+/// rate. Instead of drawing once per site, it draws the number of sites skipped before each hit:
+/// P(gap = k) = (1 - rate)^k * rate, sampled by inversion as floor(log(U) / log(1 - rate)) with U uniform in (0, 1].
+/// That's one draw per hit (plus one), rather than one per site.
+class GeometricSkip {
+protected:
+  double rate=0;
+  double log_miss=0;  ///< log(1 - rate)
+
+public:
+  GeometricSkip(double r=0) { SetRate(r); }
+
+  double GetRate() const { return rate; }
+
+  void SetRate(double r) {
+    rate = r;
+    log_miss = std::log1p(-r);
+  }
+
+  /// Number of sites skipped before the next hit, or limit if that's at least limit.
+  size_t NextGap(emp::Random& random, size_t limit) const {
+    if (rate <= 0) return limit;
+    if (rate >= 1) return 0;
+    const double gap = std::floor(std::log(1.0 - random.GetDouble()) / log_miss);
+    return (gap < (double)limit) ? (size_t)gap : limit;
+  }
+
+  /// Call fun(site) for each hit site in [0, num_sites), in increasing order.
+  template<typename FUN_T>
+  void ForEachHit(size_t num_sites, emp::Random& random, FUN_T fun) const {
+    size_t site = NextGap(random, num_sites);
+    while (site < num_sites) {
+      fun(site);
+      site += 1 + NextGap(random, num_sites - site - 1);
+    }
+  }
+
+};
+
+} // namespace dirdevo
+
+#endif // #ifndef DIRECTED_DEVO_DIRECTED_DEVO_GEOMETRIC_SKIP_HPP_INCLUDE
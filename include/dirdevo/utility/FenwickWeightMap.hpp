@@ -0,0 +1,135 @@
+/**
+ * @file FenwickWeightMap.hpp
+ * @brief Drop-in alternative to emp::IndexMap (for the parts of its interface the schedulers use) backed by a flat Fenwick tree.
+ *
+ * A Fenwick (binary indexed) tree keeps partial sums in one contiguous array: lookups descend by halving a power-of-two step,
+ * and adjustments touch O(log N) entries. Used by ProbabilisticScheduler when compiled with DIRDEVO_FENWICK_SCHEDULER.
+ */
+
+#pragma once
+#ifndef DIRECTED_DEVO_UTILITY_FENWICK_WEIGHT_MAP_HPP_INCLUDE
+#define DIRECTED_DEVO_UTILITY_FENWICK_WEIGHT_MAP_HPP_INCLUDE
+
+#include <algorithm>
+#include <cstddef>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+namespace dirdevo {
+
+/// FenwickWeightMap maps item ids [0, N) to non-negative weights and supports weighted random lookups.
+/// - Index(x) returns the item whose cumulative weight range contains x (0 <= x < GetWeight()).
+/// - Adjust is O(log N). DeferRefresh lets bulk adjustments skip tree updates; the tree is rebuilt in O(N) on the next lookup.
+/// - To keep floating point drift from accumulating, the tree is rebuilt from scratch after every N incremental adjustments.
+class FenwickWeightMap {
+protected:
+  emp::vector<double> weights;  ///< Raw item weights.
+  mutable emp::vector<double> tree;   ///< Fenwick tree over weights (1-indexed; tree[0] unused).
+  size_t top_step=0;                  ///< Largest power of two <= number of items.
+  mutable double total_weight=0;      ///< Sum of all weights.
+  mutable size_t adjustments=0;       ///< Incremental adjustments since the last rebuild.
+  mutable bool needs_refresh=false;   ///< Have weights changed without updating the tree?
+
+  void Rebuild() const {
+    const size_t n = weights.size();
+    tree[0] = 0;
+    std::copy(weights.begin(), weights.end(), tree.begin()+1);
+    for (size_t i = 1; i <= n; ++i) {
+      const size_t parent = i + (i & (~i + 1));
+      if (parent <= n) tree[parent] += tree[i];
+    }
+    total_weight = 0;
+    for (double w : weights) total_weight += w;
+    adjustments = 0;
+    needs_refresh = false;
+  }
+
+  void Refresh() const {
+    if (needs_refresh) Rebuild();
+  }
+
+public:
+
+  FenwickWeightMap(size_t num_items=0) { ResizeClear(num_items); }
+
+  size_t GetSize() const { return weights.size(); }
+  size_t size() const { return weights.size(); }
+
+  /// Total weight of all items.
+  double GetWeight() const { Refresh(); return total_weight; }
+
+  /// Weight of a single item.
+  double GetWeight(size_t id) const {
+    emp_assert(id < weights.size(), id, weights.size());
+    return weights[id];
+  }
+
+  double operator[](size_t id) const { return GetWeight(id); }
+
+  /// Skip tree maintenance until the next lookup (use before a batch of adjustments).
+  void DeferRefresh() { needs_refresh = true; }
+
+  /// Change the weight of an item.
+  void Adjust(size_t id, double new_weight) {
+    emp_assert(id < weights.size(), id, weights.size());
+    emp_assert(new_weight >= 0, new_weight);
+    const double delta = new_weight - weights[id];
+    weights[id] = new_weight;
+    if (needs_refresh || delta == 0) return;
+    if (++adjustments >= weights.size()) {
+      needs_refresh = true; // Periodically rebuild to wash out accumulated rounding error.
+      return;
+    }
+    const size_t n = weights.size();
+    for (size_t i = id+1; i <= n; i += (i & (~i + 1))) {
+      tree[i] += delta;
+    }
+    total_weight += delta;
+  }
+
+  /// Find the item whose cumulative weight range contains x.
+  size_t Index(double x) const {
+    Refresh();
+    emp_assert(weights.size() > 0);
+    emp_assert(x >= 0 && x < total_weight, x, total_weight);
+    size_t pos = 0;
+    const size_t n = weights.size();
+    for (size_t step = top_step; step; step >>= 1) {
+      const size_t next = pos + step;
+      if (next <= n && tree[next] <= x) {
+        x -= tree[next];
+        pos = next;
+      }
+    }
+    // pos is the (0-indexed) item id. Rounding can, very rarely, land past the end or on an empty item; back up to a weighted one.
+    if (pos >= n) pos = n-1;
+    if (weights[pos] == 0) {
+      size_t fallback = pos;
+      while (fallback > 0 && weights[fallback] == 0) --fallback;
+      if (weights[fallback] == 0) {
+        fallback = pos;
+        while (fallback+1 < n && weights[fallback] == 0) ++fallback;
+      }
+      pos = fallback;
+    }
+    return pos;
+  }
+
+  /// Resize to num_items items, setting every weight to 0.
+  void ResizeClear(size_t num_items) {
+    weights.assign(num_items, 0);
+    tree.assign(num_items+1, 0);
+    top_step = 1;
+    while (num_items && top_step <= num_items / 2) top_step <<= 1;
+    if (!num_items) top_step = 0;
+    total_weight = 0;
+    adjustments = 0;
+    needs_refresh = false;
+  }
+
+};
+
+} // namespace dirdevo
+
+#endif // #ifndef DIRECTED_DEVO_UTILITY_FENWICK_WEIGHT_MAP_HPP_INCLUDE
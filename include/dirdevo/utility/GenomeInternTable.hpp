@@ -0,0 +1,196 @@
+/**
+ * @file GenomeInternTable.hpp
+ * @brief Deduplicated, reference-counted storage for genomes (hash-consing).
+ *
+ * Interning a genome returns a small integer handle; every subsystem that interns an identical genome gets the same
+ * handle, and the table stores a single immutable copy. Handles can be compared, hashed, and used as map keys in O(1),
+ * which is much cheaper than copying/comparing full genomes.
+ */
+
+#pragma once
+#ifndef DIRECTED_DEVO_UTILITY_GENOME_INTERN_TABLE_HPP_INCLUDE
+#define DIRECTED_DEVO_UTILITY_GENOME_INTERN_TABLE_HPP_INCLUDE
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/Ptr.hpp"
+#include "emp/base/vector.hpp"
+
+namespace dirdevo {
+
+/// Finalizer from splitmix64; spreads the bits of x across the full 64-bit word.
+inline uint64_t MixHash64(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+/// Fold value into a running 64-bit hash.
+inline uint64_t CombineHash64(uint64_t hash, uint64_t value) {
+  return MixHash64(hash ^ (value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2)));
+}
+
+/// Computes a 64-bit content hash of a genome. By default, defers to std::hash.
+/// Specialize for genome types that don't have a std::hash specialization (or that have a slow one).
+template <typename GENOME>
+struct GenomeHasher {
+  uint64_t operator()(const GENOME& genome) const {
+    return MixHash64((uint64_t)std::hash<GENOME>()(genome));
+  }
+};
+
+/// GenomeInternTable stores one copy of each distinct genome that has been interned.
+/// - Intern increments the genome's reference count; Release decrements it. Genomes with no references are freed,
+///   and their handles get recycled.
+/// - Intern, Retain, and Release are thread-safe. Get is not synchronized: it must not be called concurrently with
+///   Intern (which can grow the table), but references returned by Get stay valid until the genome is released.
+template <typename GENOME, typename HASHER=GenomeHasher<GENOME>>
+class GenomeInternTable {
+public:
+  using genome_t = GENOME;
+  using hasher_t = HASHER;
+  using handle_t = uint32_t;
+
+  static constexpr handle_t NO_HANDLE = std::numeric_limits<handle_t>::max();
+
+protected:
+
+  struct Entry {
+    emp::Ptr<const genome_t> genome=nullptr;  ///< Owned copy of the genome (nullptr if this handle is free).
+    uint64_t hash=0;
+    size_t refs=0;
+  };
+
+  emp::vector<Entry> entries;                         ///< Indexed by handle.
+  emp::vector<handle_t> free_handles;                 ///< Handles whose genomes have been released.
+  std::unordered_multimap<uint64_t, handle_t> index;  ///< Content hash => handle(s) with that hash.
+  size_t num_genomes=0;
+  hasher_t hasher;
+  mutable std::mutex mutex;
+
+  /// Find the handle for genome (given its hash). Caller must hold the lock.
+  handle_t FindLocked(const genome_t& genome, uint64_t hash) const {
+    auto range = index.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (*(entries[it->second].genome) == genome) return it->second;
+    }
+    return NO_HANDLE;
+  }
+
+public:
+
+  GenomeInternTable() = default;
+  GenomeInternTable(const GenomeInternTable&) = delete;
+  GenomeInternTable& operator=(const GenomeInternTable&) = delete;
+
+  ~GenomeInternTable() { Clear(); }
+
+  /// How many distinct genomes are currently stored?
+  size_t GetNumGenomes() const { return num_genomes; }
+
+  /// Get the content hash of a genome (without interning it).
+  uint64_t Hash(const genome_t& genome) const { return hasher(genome); }
+
+  /// Get a reference (incrementing its reference count) to the given genome, storing a copy if it isn't already in the table.
+  handle_t Intern(const genome_t& genome) {
+    const uint64_t hash = hasher(genome);
+    std::lock_guard<std::mutex> lock(mutex);
+    handle_t handle = FindLocked(genome, hash);
+    if (handle == NO_HANDLE) {
+      if (free_handles.size()) {
+        handle = free_handles.back();
+        free_handles.pop_back();
+      } else {
+        emp_assert(entries.size() < NO_HANDLE);
+        handle = (handle_t)entries.size();
+        entries.emplace_back();
+      }
+      Entry& entry = entries[handle];
+      entry.genome = emp::NewPtr<const genome_t>(genome);
+      entry.hash = hash;
+      entry.refs = 0;
+      index.emplace(hash, handle);
+      ++num_genomes;
+    }
+    ++entries[handle].refs;
+    return handle;
+  }
+
+  /// Look up the handle of a genome without interning it. Returns NO_HANDLE if the genome isn't in the table.
+  handle_t Find(const genome_t& genome) const {
+    const uint64_t hash = hasher(genome);
+    std::lock_guard<std::mutex> lock(mutex);
+    return FindLocked(genome, hash);
+  }
+
+  /// Add a reference to an already-interned genome.
+  void Retain(handle_t handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    emp_assert(handle < entries.size() && entries[handle].genome, handle);
+    ++entries[handle].refs;
+  }
+
+  /// Drop a reference to an interned genome; the genome is freed once it has no references left.
+  void Release(handle_t handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    emp_assert(handle < entries.size() && entries[handle].genome, handle);
+    Entry& entry = entries[handle];
+    emp_assert(entry.refs > 0);
+    if (--entry.refs) return;
+    auto range = index.equal_range(entry.hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == handle) {
+        index.erase(it);
+        break;
+      }
+    }
+    entry.genome.Delete();
+    entry.genome = nullptr;
+    free_handles.emplace_back(handle);
+    --num_genomes;
+  }
+
+  /// Get the genome associated with handle.
+  const genome_t& Get(handle_t handle) const {
+    emp_assert(handle < entries.size() && entries[handle].genome, handle);
+    return *(entries[handle].genome);
+  }
+
+  /// Get the content hash of an interned genome.
+  uint64_t GetHash(handle_t handle) const {
+    emp_assert(handle < entries.size() && entries[handle].genome, handle);
+    return entries[handle].hash;
+  }
+
+  /// How many references are there to the given genome?
+  size_t GetRefCount(handle_t handle) const {
+    emp_assert(handle < entries.size());
+    return entries[handle].refs;
+  }
+
+  /// Free every stored genome (invalidates all handles).
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (Entry& entry : entries) {
+      if (entry.genome) entry.genome.Delete();
+    }
+    entries.clear();
+    free_handles.clear();
+    index.clear();
+    num_genomes=0;
+  }
+
+};
+
+} // namespace dirdevo
+
+#endif // #ifndef DIRECTED_DEVO_UTILITY_GENOME_INTERN_TABLE_HPP_INCLUDE
@@ -0,0 +1,129 @@
+/**
+ * @file HashedGenome.hpp
+ * @brief Genome plus a 64-bit content hash, used as taxon info by the systematics manager.
+ */
+
+#pragma once
+#ifndef DIRECTED_DEVO_UTILITY_HASHED_GENOME_HPP_INCLUDE
+#define DIRECTED_DEVO_UTILITY_HASHED_GENOME_HPP_INCLUDE
+
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/Ptr.hpp"
+
+#include "GenomeInternTable.hpp"
+
+namespace dirdevo {
+
+/// Does ORG_T maintain a hash of its own genome (i.e., have GetGenomeHash())?
+template<typename ORG_T, typename=void>
+struct HasGenomeHash : std::false_type { };
+
+template<typename ORG_T>
+struct HasGenomeHash<ORG_T, std::void_t<decltype(std::declval<const ORG_T&>().GetGenomeHash())>> : std::true_type { };
+
+/// Hash of org's genome: the organism's own (incrementally maintained) hash if it has one; otherwise, GenomeHasher's.
+/// Hashes from different sources must not be mixed within one systematics manager (every organism of a given type uses
+/// the same source, so this holds).
+template<typename ORG_T>
+uint64_t GetOrgGenomeHash(const ORG_T& org) {
+  if constexpr (HasGenomeHash<ORG_T>::value) {
+    return org.GetGenomeHash();
+  } else {
+    return GenomeHasher<typename ORG_T::genome_t>()(org.GetGenome());
+  }
+}
+
+/// HashedGenome is taxon info for emp::Systematics: a genome and its hash. Comparisons check hashes first, so
+/// genomes are only compared in full when their hashes match.
+/// A key made with View borrows the genome (no copy), which is what the systematics manager's info function returns
+/// for every organism it's given. Copying a key (e.g., when the systematics manager stores it in a new taxon) makes an
+/// owning copy, so only new taxa copy genomes. Copies of owning keys share the same immutable genome.
+/// NOTE - A borrowed key must not outlive the genome it views.
+template<typename GENOME>
+class HashedGenome {
+public:
+  using genome_t = GENOME;
+
+protected:
+  uint64_t hash=0;
+  emp::Ptr<const genome_t> borrowed=nullptr;
+  std::shared_ptr<const genome_t> owned;
+
+  HashedGenome(emp::Ptr<const genome_t> genome, uint64_t genome_hash) : hash(genome_hash), borrowed(genome) { ; }
+
+  const genome_t* GetPtr() const { return owned ? owned.get() : borrowed.Raw(); }
+
+  static std::shared_ptr<const genome_t> Own(const HashedGenome& key) {
+    if (key.owned || !key.borrowed) return key.owned;
+    return std::make_shared<const genome_t>(*key.borrowed);
+  }
+
+public:
+  HashedGenome() = default;
+
+  HashedGenome(const genome_t& genome, uint64_t genome_hash)
+    : hash(genome_hash), owned(std::make_shared<const genome_t>(genome)) { ; }
+
+  // Copies always own their genome. (There's intentionally no move constructor: moving a borrowed key copies too.)
+  HashedGenome(const HashedGenome& other) : hash(other.hash), owned(Own(other)) { ; }
+
+  HashedGenome& operator=(const HashedGenome& other) {
+    if (this == &other) return *this;
+    owned = Own(other);
+    borrowed = nullptr;
+    hash = other.hash;
+    return *this;
+  }
+
+  /// Key that borrows genome (see class notes).
+  static HashedGenome View(const genome_t& genome, uint64_t genome_hash) {
+    return HashedGenome(emp::Ptr<const genome_t>(&genome), genome_hash);
+  }
+
+  uint64_t GetHash() const { return hash; }
+  bool HasGenome() const { return GetPtr() != nullptr; }
+  bool IsBorrowed() const { return !owned && borrowed; }
+  const genome_t& GetGenome() const { emp_assert(HasGenome()); return *GetPtr(); }
+
+  bool operator==(const HashedGenome& other) const {
+    if (hash != other.hash) return false;
+    const genome_t* genome = GetPtr();
+    const genome_t* other_genome = other.GetPtr();
+    if (genome == other_genome) return true;
+    return genome && other_genome && *genome == *other_genome;
+  }
+
+  bool operator!=(const HashedGenome& other) const { return !(*this == other); }
+
+};
+
+template<typename STREAM_T, typename T, typename=void>
+struct IsStreamable : std::false_type { };
+
+template<typename STREAM_T, typename T>
+struct IsStreamable<STREAM_T, T, std::void_t<decltype(std::declval<STREAM_T&>() << std::declval<const T&>())>> : std::true_type { };
+
+/// Prints the genome if it's printable; otherwise, the hash (in hex).
+template<typename GENOME>
+std::ostream& operator<<(std::ostream& os, const HashedGenome<GENOME>& key) {
+  if constexpr (IsStreamable<std::ostream, GENOME>::value) {
+    if (key.HasGenome()) return os << key.GetGenome();
+  }
+  const auto flags = os.flags();
+  const auto fill = os.fill('0');
+  os << std::hex << std::setw(16) << key.GetHash();
+  os.fill(fill);
+  os.flags(flags);
+  return os;
+}
+
+} // namespace dirdevo
+
+#endif // #ifndef DIRECTED_DEVO_UTILITY_HASHED_GENOME_HPP_INCLUDE
@@ -0,0 +1,114 @@
+/**
+ * @file InlineBuffer.hpp
+ * @brief Small, allocation-free buffers for virtual hardware: InlineBuffer (owning) and BufferView (non-owning).
+ */
+
+#pragma once
+#ifndef DIRECTED_DEVO_UTILITY_INLINE_BUFFER_HPP_INCLUDE
+#define DIRECTED_DEVO_UTILITY_INLINE_BUFFER_HPP_INCLUDE
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+namespace dirdevo {
+
+/// InlineBuffer stores up to CAPACITY values inline (no heap allocation).
+/// If it overflows, its contents move to a heap-allocated overflow vector until the next clear (clearing keeps the
+/// overflow vector's capacity, so a buffer that overflows regularly only allocates once).
+template<typename T, size_t CAPACITY>
+class InlineBuffer {
+public:
+  using value_type = T;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  static constexpr size_t INLINE_CAPACITY = CAPACITY;
+
+protected:
+  std::array<T, CAPACITY> values;
+  emp::vector<T> overflow;
+  size_t count=0;
+  bool spilled=false;
+
+public:
+
+  size_t size() const { return count; }
+  bool empty() const { return !count; }
+  bool IsSpilled() const { return spilled; }
+
+  T* data() { return spilled ? overflow.data() : values.data(); }
+  const T* data() const { return spilled ? overflow.data() : values.data(); }
+
+  iterator begin() { return data(); }
+  iterator end() { return data() + count; }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + count; }
+
+  T& operator[](size_t i) { emp_assert(i < count, i, count); return data()[i]; }
+  const T& operator[](size_t i) const { emp_assert(i < count, i, count); return data()[i]; }
+
+  void clear() {
+    count = 0;
+    spilled = false;
+    overflow.clear();
+  }
+
+  template<typename... ARGS>
+  T& emplace_back(ARGS&&... args) {
+    if (!spilled && count < CAPACITY) {
+      values[count] = T(std::forward<ARGS>(args)...);
+      return values[count++];
+    }
+    if (!spilled) {
+      overflow.assign(values.begin(), values.begin() + count);
+      spilled = true;
+    }
+    overflow.emplace_back(std::forward<ARGS>(args)...);
+    ++count;
+    return overflow.back();
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+
+};
+
+/// BufferView is a non-owning, read-only view of contiguous values (e.g., an environment's input buffer).
+/// Whatever owns the viewed values must outlive the view.
+template<typename T>
+class BufferView {
+public:
+  using value_type = T;
+  using const_iterator = const T*;
+
+protected:
+  const T* values=nullptr;
+  size_t count=0;
+
+public:
+  BufferView() = default;
+  BufferView(const T* v, size_t n) : values(v), count(n) { ; }
+  BufferView(const emp::vector<T>& vec) : values(vec.data()), count(vec.size()) { ; }
+
+  size_t size() const { return count; }
+  bool empty() const { return !count; }
+  const T* data() const { return values; }
+
+  const_iterator begin() const { return values; }
+  const_iterator end() const { return values + count; }
+
+  const T& operator[](size_t i) const { emp_assert(i < count, i, count); return values[i]; }
+
+  bool operator==(const emp::vector<T>& vec) const {
+    return count == vec.size() && std::equal(begin(), end(), vec.begin());
+  }
+
+};
+
+} // namespace dirdevo
+
+#endif // #ifndef DIRECTED_DEVO_UTILITY_INLINE_BUFFER_HPP_INCLUDE
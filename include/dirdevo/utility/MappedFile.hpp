@@ -0,0 +1,58 @@
+/**
+ * @file MappedFile.hpp
+ * @brief Read-only memory-mapped file (POSIX mmap).
+ */
+
+#pragma once
+#ifndef DIRECTED_DEVO_UTILITY_MAPPED_FILE_HPP_INCLUDE
+#define DIRECTED_DEVO_UTILITY_MAPPED_FILE_HPP_INCLUDE
+
+#include <cstddef>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dirdevo {
+
+/// MappedFile maps an entire file into memory, read-only, for as long as the MappedFile exists.
+/// Pages are shared with every other process that maps the same file (e.g., many jobs on a node reading the same data).
+/// If the file can't be opened or mapped, IsOpen() is false.
+class MappedFile {
+protected:
+  const char* data=nullptr;
+  size_t size=0;
+
+public:
+  MappedFile(const std::string& path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+      void* mapped = mmap(nullptr, (size_t)file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+      if (mapped != MAP_FAILED) {
+        data = static_cast<const char*>(mapped);
+        size = (size_t)file_stat.st_size;
+      }
+    }
+    close(fd); // The mapping stays valid after the descriptor is closed.
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile() {
+    if (data) munmap(const_cast<char*>(data), size);
+  }
+
+  bool IsOpen() const { return data != nullptr; }
+  const char* GetData() const { return data; }
+  size_t GetSize() const { return size; }
+
+};
+
+} // namespace dirdevo
+
+#endif // #ifndef DIRECTED_DEVO_UTILITY_MAPPED_FILE_HPP_INCLUDE
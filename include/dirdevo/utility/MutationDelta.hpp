@@ -0,0 +1,85 @@
+/**
+ * @file MutationDelta.hpp
+ * @brief Compact record of the substitutions a mutator applied to a genome (what changed relative to the parent).
+ */
+
+#pragma once
+#ifndef DIRECTED_DEVO_UTILITY_MUTATION_DELTA_HPP_INCLUDE
+#define DIRECTED_DEVO_UTILITY_MUTATION_DELTA_HPP_INCLUDE
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "InlineBuffer.hpp"
+
+namespace dirdevo {
+
+/// Genomes are viewed as flat sequences of integer-valued fields (sites) for delta purposes.
+/// Specialize for genome types that support mutation deltas, providing:
+/// - static uint32_t Get(const GENOME& genome, size_t site)
+/// - static void Set(GENOME& genome, size_t site, uint32_t value)
+template<typename GENOME>
+struct GenomeFields;
+
+/// MutationDelta lists the field substitutions applied to a genome (in the order they were applied).
+/// Applying a delta to the parent's genome reproduces the offspring's; deltas are usually a handful of edits, so they're
+/// stored inline.
+class MutationDelta {
+public:
+  struct Edit {
+    uint32_t site=0;       ///< Field index (see GenomeFields)
+    uint32_t old_value=0;
+    uint32_t new_value=0;
+  };
+
+  using buffer_t = InlineBuffer<Edit, 16>;
+
+protected:
+  buffer_t edits;
+
+public:
+
+  size_t size() const { return edits.size(); }
+  bool empty() const { return edits.empty(); }
+  void clear() { edits.clear(); }
+
+  typename buffer_t::const_iterator begin() const { return edits.begin(); }
+  typename buffer_t::const_iterator end() const { return edits.end(); }
+
+  void Record(size_t site, uint32_t old_value, uint32_t new_value) {
+    edits.emplace_back(Edit{(uint32_t)site, old_value, new_value});
+  }
+
+};
+
+/// Apply edits [begin, end) (in order) to genome.
+template<typename GENOME, typename ITER_T>
+void ApplyMutationEdits(GENOME& genome, ITER_T begin, ITER_T end) {
+  for (ITER_T it = begin; it != end; ++it) {
+    GenomeFields<GENOME>::Set(genome, it->site, it->new_value);
+  }
+}
+
+/// Does ORG_T record the mutations applied at its birth (i.e., have GetBirthDelta())?
+template<typename ORG_T, typename=void>
+struct HasBirthDelta : std::false_type { };
+
+template<typename ORG_T>
+struct HasBirthDelta<ORG_T, std::void_t<decltype(std::declval<ORG_T&>().GetBirthDelta())>> : std::true_type { };
+
+/// Mutate org's genome with mutator, recording the mutations in org's birth delta if it keeps one.
+/// Organisms that keep a birth delta rely on it (e.g., to update their genome hash), so mutation functions for
+/// offspring should go through here rather than calling the mutator directly.
+template<typename MUTATOR_T, typename ORG_T, typename RANDOM_T>
+size_t MutateOrganism(MUTATOR_T& mutator, ORG_T& org, RANDOM_T& random) {
+  if constexpr (HasBirthDelta<ORG_T>::value) {
+    return mutator.Mutate(org.GetGenome(), random, &org.GetBirthDelta());
+  } else {
+    return mutator.Mutate(org.GetGenome(), random);
+  }
+}
+
+} // namespace dirdevo
+
+#endif // #ifndef DIRECTED_DEVO_UTILITY_MUTATION_DELTA_HPP_INCLUDE
@@ -0,0 +1,94 @@
+/**
+ * @file OrganismPool.hpp
+ * @brief Recycles organisms that have been removed from a world, so births don't have to allocate new ones.
+ */
+
+#pragma once
+#ifndef DIRECTED_DEVO_UTILITY_ORGANISM_POOL_HPP_INCLUDE
+#define DIRECTED_DEVO_UTILITY_ORGANISM_POOL_HPP_INCLUDE
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/Ptr.hpp"
+#include "emp/base/vector.hpp"
+
+namespace dirdevo {
+
+/// Does ORG_T know how to reinitialize itself in place from a genome? (i.e., void Recycle(const genome_t&))
+template<typename ORG_T, typename=void>
+struct HasRecycle : std::false_type { };
+
+template<typename ORG_T>
+struct HasRecycle<
+  ORG_T,
+  std::void_t<decltype(std::declval<ORG_T&>().Recycle(std::declval<const typename ORG_T::genome_t&>()))>
+> : std::true_type { };
+
+/// OrganismPool holds organisms that are no longer in a population.
+/// - Acquire reuses a pooled organism if there is one (otherwise, it allocates a new one).
+///   - Organisms that implement Recycle(genome) are reinitialized in place; recycling should leave the organism in the
+///     same state as a newly constructed one, but may keep allocated buffer capacity.
+///   - Other organisms are destroyed and reconstructed in place (which reuses the organism's memory, but not its members').
+/// - Release hands an organism back to the pool. The pool owns (and eventually deletes) released organisms.
+template<typename ORG_T>
+class OrganismPool {
+public:
+  using org_t = ORG_T;
+  using genome_t = typename org_t::genome_t;
+
+protected:
+  emp::vector<emp::Ptr<org_t>> free_orgs;
+  size_t num_allocated=0;  ///< Number of organisms Acquire had to allocate.
+  size_t num_recycled=0;   ///< Number of organisms Acquire reused.
+
+public:
+  OrganismPool() = default;
+  OrganismPool(const OrganismPool&) = delete;
+  OrganismPool& operator=(const OrganismPool&) = delete;
+
+  ~OrganismPool() { Clear(); }
+
+  size_t GetSize() const { return free_orgs.size(); }
+  size_t GetNumAllocated() const { return num_allocated; }
+  size_t GetNumRecycled() const { return num_recycled; }
+
+  /// Get an organism built from the given genome.
+  emp::Ptr<org_t> Acquire(const genome_t& genome) {
+    if (free_orgs.empty()) {
+      ++num_allocated;
+      return emp::NewPtr<org_t>(genome);
+    }
+    emp::Ptr<org_t> org = free_orgs.back();
+    free_orgs.pop_back();
+    if constexpr (HasRecycle<org_t>::value) {
+      org->Recycle(genome);
+    } else {
+      org_t* raw = org.Raw();
+      raw->~org_t();
+      new (raw) org_t(genome);
+    }
+    ++num_recycled;
+    return org;
+  }
+
+  /// Give an organism (that is no longer in use anywhere else) to the pool.
+  void Release(emp::Ptr<org_t> org) {
+    emp_assert(org);
+    free_orgs.emplace_back(org);
+  }
+
+  /// Delete every pooled organism.
+  void Clear() {
+    for (auto org : free_orgs) org.Delete();
+    free_orgs.clear();
+  }
+
+};
+
+} // namespace dirdevo
+
+#endif // #ifndef DIRECTED_DEVO_UTILITY_ORGANISM_POOL_HPP_INCLUDE
@@ -0,0 +1,417 @@
+/**
+ * @file PhylogenyLog.hpp
+ * @brief Incremental, binary phylogeny snapshots: PhylogenyLogWriter appends what changed since the last snapshot;
+ *        PhylogenyLogReader reconstructs the phylogeny as of any snapshot.
+ *
+ * File format (all integers are LEB128 varints; "zz" marks zigzag-encoded signed values):
+ * - Header: the 8 bytes "DDPHYLO\0", then the format version.
+ * - One block per snapshot: payload size (bytes), then the payload:
+ *   - epoch
+ *   - New taxa: count, then one column at a time: ids (zz delta from the previous id), parents (0 for none, otherwise
+ *     zz(id - parent id) + 1), origin times (zz delta from the previous origin time), info (byte length, then the bytes).
+ *   - Deaths (extinctions): count, then ids (zz delta), destruction times (zz delta).
+ *   - Pruned taxa (removed from the phylogeny): count, then ids (zz delta).
+ *   - Count updates: count, then ids (zz delta), then one column each for num_orgs, tot_orgs, num_offspring, and
+ *     total_offspring (see TaxonCounts).
+ * Columns of small deltas (and of similar genomes) compress well (e.g., with gzip) if the file needs to be archived.
+ * A snapshot's phylogeny is every taxon added in blocks up to and including its block, minus those pruned in them. Each
+ * taxon's counts are the ones from the last count update for it (up to and including the snapshot's block).
+ */
+
+#pragma once
+#ifndef DIRECTED_DEVO_UTILITY_PHYLOGENY_LOG_HPP_INCLUDE
+#define DIRECTED_DEVO_UTILITY_PHYLOGENY_LOG_HPP_INCLUDE
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "emp/base/vector.hpp"
+
+#include "MappedFile.hpp"
+
+namespace dirdevo {
+
+namespace phylogeny_log {
+
+  constexpr char MAGIC[8] = {'D', 'D', 'P', 'H', 'Y', 'L', 'O', '\0'};
+  constexpr uint64_t VERSION = 2;
+  constexpr uint64_t NO_PARENT = std::numeric_limits<uint64_t>::max();
+
+  /// Per-taxon counts, as emp::Systematics tracks them. Unlike the rest of a taxon's record, these change over time, so
+  /// they're logged whenever they're (re)set.
+  struct TaxonCounts {
+    uint64_t num_orgs=0;        ///< Organisms currently in the taxon
+    uint64_t tot_orgs=0;        ///< Organisms ever in the taxon
+    uint64_t num_offspring=0;   ///< Direct offspring taxa
+    uint64_t total_offspring=0; ///< Descendant taxa (direct or indirect)
+  };
+
+  inline void PutVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+      out.push_back((char)((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    out.push_back((char)value);
+  }
+
+  inline uint64_t ZigzagEncode(int64_t value) { return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63); }
+  inline int64_t ZigzagDecode(uint64_t value) { return (int64_t)(value >> 1) ^ -(int64_t)(value & 1); }
+
+  inline void PutZigzag(std::string& out, int64_t value) { PutVarint(out, ZigzagEncode(value)); }
+
+  inline void PutBytes(std::string& out, const std::string& bytes) {
+    PutVarint(out, bytes.size());
+    out.append(bytes);
+  }
+
+  /// Parent column entry for taxon id: 0 for none, otherwise zz(id - parent) + 1.
+  inline uint64_t EncodeParent(uint64_t id, uint64_t parent) {
+    return (parent == NO_PARENT) ? 0 : ZigzagEncode((int64_t)(id - parent)) + 1;
+  }
+
+  inline uint64_t DecodeParent(uint64_t id, uint64_t code) {
+    return (code) ? id - (uint64_t)ZigzagDecode(code - 1) : NO_PARENT;
+  }
+
+  /// Reads varints from [pos, end). Reading past end (or a malformed varint) sets the failed flag and returns 0.
+  struct Cursor {
+    const unsigned char* pos=nullptr;
+    const unsigned char* end=nullptr;
+    bool failed=false;
+
+    uint64_t GetVarint() {
+      uint64_t value = 0;
+      for (size_t shift = 0; shift < 64; shift += 7) {
+        if (pos >= end) break;
+        const unsigned char byte = *pos++;
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return value;
+      }
+      failed = true;
+      return 0;
+    }
+
+    int64_t GetZigzag() { return ZigzagDecode(GetVarint()); }
+
+    void GetBytes(std::string& bytes) {
+      const uint64_t size = GetVarint();
+      if (failed || size > (uint64_t)(end - pos)) {
+        failed = true;
+        bytes.clear();
+        return;
+      }
+      bytes.assign(reinterpret_cast<const char*>(pos), size);
+      pos += size;
+    }
+  };
+
+}
+
+/// PhylogenyLogWriter collects phylogeny changes (new taxa, extinctions, prunes, and count updates) as they happen, and
+/// appends them to its file as one block per WriteSnapshot call. Each snapshot costs time and space proportional to what
+/// changed since the previous snapshot, rather than to the size of the whole phylogeny.
+/// Taxa that are both added and pruned between two snapshots never appear in a snapshot, so they're left out.
+/// Changes can be recorded before the file is opened (they go into the first block).
+/// NOTE - The writer doesn't know when counts change; the owner must call SetTaxonCounts (before WriteSnapshot) for every
+///        taxon whose counts may have changed since the last snapshot, including new taxa.
+class PhylogenyLogWriter {
+public:
+  static constexpr uint64_t NO_PARENT = phylogeny_log::NO_PARENT;
+  using TaxonCounts = phylogeny_log::TaxonCounts;
+
+protected:
+  struct NewTaxon {
+    uint64_t id=0;
+    uint64_t parent=NO_PARENT;
+    int64_t origin_time=0;
+    std::string info;
+    bool pruned=false;
+  };
+
+  std::ofstream file;
+  emp::vector<NewTaxon> new_taxa;                       ///< Taxa added since the last snapshot
+  std::unordered_map<uint64_t, size_t> new_taxa_index;  ///< Taxon id => index in new_taxa
+  emp::vector<std::pair<uint64_t, int64_t>> deaths;     ///< (Taxon id, destruction time) since the last snapshot
+  emp::vector<uint64_t> pruned;                         ///< Taxa added before the last snapshot and pruned since
+  emp::vector<std::pair<uint64_t, TaxonCounts>> count_updates; ///< (Taxon id, counts) set since the last snapshot
+  std::string block;                                    ///< Scratch (the block being encoded)
+  std::string payload;                                  ///< Scratch (the block's payload)
+
+  bool IsDropped(uint64_t id) const {
+    const auto it = new_taxa_index.find(id);
+    return it != new_taxa_index.end() && new_taxa[it->second].pruned;
+  }
+
+public:
+
+  /// Start a new log file at path (replacing any existing file). Returns whether the file could be opened.
+  bool Open(const std::string& path) {
+    if (file.is_open()) file.close();
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    block.clear();
+    block.append(phylogeny_log::MAGIC, sizeof(phylogeny_log::MAGIC));
+    phylogeny_log::PutVarint(block, phylogeny_log::VERSION);
+    file.write(block.data(), (std::streamsize)block.size());
+    file.flush();
+    return file.good();
+  }
+
+  bool IsOpen() const { return file.is_open(); }
+
+  void Close() { if (file.is_open()) file.close(); }
+
+  /// Record a new taxon. info is the taxon's info (e.g., genome) as it should appear in reconstructed snapshots.
+  void AddTaxon(uint64_t id, uint64_t parent, int64_t origin_time, const std::string& info) {
+    new_taxa_index[id] = new_taxa.size();
+    new_taxa.push_back({id, parent, origin_time, info, false});
+  }
+
+  void SetDestructionTime(uint64_t id, int64_t destruction_time) {
+    deaths.emplace_back(id, destruction_time);
+  }
+
+  /// Record id's current counts (later calls before the next snapshot win).
+  void SetTaxonCounts(uint64_t id, const TaxonCounts& counts) {
+    count_updates.emplace_back(id, counts);
+  }
+
+  void RemoveTaxon(uint64_t id) {
+    const auto it = new_taxa_index.find(id);
+    if (it != new_taxa_index.end()) {
+      new_taxa[it->second].pruned = true;
+    } else {
+      pruned.emplace_back(id);
+    }
+  }
+
+  /// Append everything recorded since the last snapshot as the block for epoch. Returns whether the write succeeded.
+  bool WriteSnapshot(size_t epoch) {
+    using namespace phylogeny_log;
+    if (!file.is_open()) return false;
+    payload.clear();
+    PutVarint(payload, epoch);
+
+    const size_t num_new = (size_t)std::count_if(new_taxa.begin(), new_taxa.end(), [](const NewTaxon& t) { return !t.pruned; });
+    PutVarint(payload, num_new);
+    uint64_t prev_id = 0;
+    for (const NewTaxon& taxon : new_taxa) {
+      if (taxon.pruned) continue;
+      PutZigzag(payload, (int64_t)(taxon.id - prev_id));
+      prev_id = taxon.id;
+    }
+    for (const NewTaxon& taxon : new_taxa) {
+      if (taxon.pruned) continue;
+      PutVarint(payload, EncodeParent(taxon.id, taxon.parent));
+    }
+    int64_t prev_time = 0;
+    for (const NewTaxon& taxon : new_taxa) {
+      if (taxon.pruned) continue;
+      PutZigzag(payload, taxon.origin_time - prev_time);
+      prev_time = taxon.origin_time;
+    }
+    for (const NewTaxon& taxon : new_taxa) {
+      if (taxon.pruned) continue;
+      PutBytes(payload, taxon.info);
+    }
+
+    const size_t num_deaths = (size_t)std::count_if(deaths.begin(), deaths.end(), [this](const auto& death) { return !IsDropped(death.first); });
+    PutVarint(payload, num_deaths);
+    prev_id = 0;
+    for (const auto& death : deaths) {
+      if (IsDropped(death.first)) continue;
+      PutZigzag(payload, (int64_t)(death.first - prev_id));
+      prev_id = death.first;
+    }
+    prev_time = 0;
+    for (const auto& death : deaths) {
+      if (IsDropped(death.first)) continue;
+      PutZigzag(payload, death.second - prev_time);
+      prev_time = death.second;
+    }
+
+    PutVarint(payload, pruned.size());
+    prev_id = 0;
+    for (uint64_t id : pruned) {
+      PutZigzag(payload, (int64_t)(id - prev_id));
+      prev_id = id;
+    }
+
+    // Sorted by id so that ids delta-encode compactly (stable, so the last update for a taxon still wins).
+    std::stable_sort(count_updates.begin(), count_updates.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    const size_t num_updates = (size_t)std::count_if(count_updates.begin(), count_updates.end(), [this](const auto& update) { return !IsDropped(update.first); });
+    PutVarint(payload, num_updates);
+    prev_id = 0;
+    for (const auto& update : count_updates) {
+      if (IsDropped(update.first)) continue;
+      PutZigzag(payload, (int64_t)(update.first - prev_id));
+      prev_id = update.first;
+    }
+    for (uint64_t TaxonCounts::* column : {&TaxonCounts::num_orgs, &TaxonCounts::tot_orgs, &TaxonCounts::num_offspring, &TaxonCounts::total_offspring}) {
+      for (const auto& update : count_updates) {
+        if (!IsDropped(update.first)) PutVarint(payload, update.second.*column);
+      }
+    }
+
+    block.clear();
+    PutVarint(block, payload.size());
+    block.append(payload);
+    file.write(block.data(), (std::streamsize)block.size());
+    file.flush();
+
+    new_taxa.clear();
+    new_taxa_index.clear();
+    deaths.clear();
+    pruned.clear();
+    count_updates.clear();
+    return file.good();
+  }
+
+};
+
+/// PhylogenyLogReader reads a file written by PhylogenyLogWriter (memory-mapped, so only the blocks that are needed for
+/// a snapshot are read).
+class PhylogenyLogReader {
+public:
+  static constexpr uint64_t NO_PARENT = phylogeny_log::NO_PARENT;
+
+  using TaxonCounts = phylogeny_log::TaxonCounts;
+
+  struct Taxon {
+    uint64_t id=0;
+    uint64_t parent=NO_PARENT;
+    int64_t origin_time=0;
+    int64_t destruction_time=0;
+    bool extinct=false;
+    TaxonCounts counts;
+    size_t depth=0;              ///< Number of ancestors (as in emp::Systematics: roots have depth 0)
+    std::string info;
+  };
+
+protected:
+  MappedFile file;
+  bool valid=false;
+  phylogeny_log::Cursor blocks;  ///< Cursor at the first block
+
+  /// Call fun(epoch, payload cursor) for each block in order until fun returns false. Returns false if the file is malformed.
+  template<typename FUN_T>
+  bool ForEachBlock(FUN_T fun) const {
+    phylogeny_log::Cursor cursor = blocks;
+    while (cursor.pos < cursor.end) {
+      const uint64_t size = cursor.GetVarint();
+      if (cursor.failed || size > (uint64_t)(cursor.end - cursor.pos)) return false;
+      phylogeny_log::Cursor payload{cursor.pos, cursor.pos + size, false};
+      cursor.pos += size;
+      const uint64_t epoch = payload.GetVarint();
+      if (payload.failed) return false;
+      if (!fun((size_t)epoch, payload)) break;
+    }
+    return true;
+  }
+
+public:
+  PhylogenyLogReader(const std::string& path) : file(path) {
+    if (!file.IsOpen() || file.GetSize() < sizeof(phylogeny_log::MAGIC)) return;
+    if (std::memcmp(file.GetData(), phylogeny_log::MAGIC, sizeof(phylogeny_log::MAGIC))) return;
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(file.GetData());
+    blocks = {data + sizeof(phylogeny_log::MAGIC), data + file.GetSize(), false};
+    valid = blocks.GetVarint() == phylogeny_log::VERSION && !blocks.failed;
+  }
+
+  /// Is this a readable phylogeny log (of a version we understand)?
+  bool IsValid() const { return valid; }
+
+  /// Epochs with a snapshot, in the order they were written.
+  emp::vector<size_t> GetEpochs() const {
+    emp::vector<size_t> epochs;
+    if (valid) ForEachBlock([&epochs](size_t epoch, phylogeny_log::Cursor&) { epochs.emplace_back(epoch); return true; });
+    return epochs;
+  }
+
+  /// Reconstruct the phylogeny as of the snapshot for epoch (sorted by taxon id). Returns false if there's no such
+  /// snapshot or the file is malformed.
+  bool Reconstruct(size_t epoch, emp::vector<Taxon>& taxa) const {
+    taxa.clear();
+    if (!valid) return false;
+    std::unordered_map<uint64_t, Taxon> phylogeny;
+    bool found = false;
+    bool ok = true;
+    const bool well_formed = ForEachBlock([&](size_t block_epoch, phylogeny_log::Cursor& payload) {
+      emp::vector<uint64_t> ids;
+      // New taxa
+      ids.resize(payload.GetVarint());
+      uint64_t prev_id = 0;
+      for (uint64_t& id : ids) id = prev_id = prev_id + (uint64_t)payload.GetZigzag();
+      emp::vector<uint64_t> parents(ids.size());
+      for (size_t i = 0; i < ids.size(); ++i) parents[i] = phylogeny_log::DecodeParent(ids[i], payload.GetVarint());
+      int64_t prev_time = 0;
+      for (size_t i = 0; i < ids.size(); ++i) {
+        prev_time += payload.GetZigzag();
+        Taxon& taxon = phylogeny[ids[i]];
+        taxon.id = ids[i];
+        taxon.parent = parents[i];
+        taxon.origin_time = prev_time;
+      }
+      for (uint64_t id : ids) payload.GetBytes(phylogeny[id].info);
+      // Deaths
+      ids.resize(payload.GetVarint());
+      prev_id = 0;
+      for (uint64_t& id : ids) id = prev_id = prev_id + (uint64_t)payload.GetZigzag();
+      prev_time = 0;
+      for (uint64_t id : ids) {
+        prev_time += payload.GetZigzag();
+        auto it = phylogeny.find(id);
+        if (it == phylogeny.end()) continue;
+        it->second.destruction_time = prev_time;
+        it->second.extinct = true;
+      }
+      // Prunes
+      ids.resize(payload.GetVarint());
+      prev_id = 0;
+      for (uint64_t& id : ids) id = prev_id = prev_id + (uint64_t)payload.GetZigzag();
+      for (uint64_t id : ids) phylogeny.erase(id);
+      // Count updates
+      ids.resize(payload.GetVarint());
+      prev_id = 0;
+      for (uint64_t& id : ids) id = prev_id = prev_id + (uint64_t)payload.GetZigzag();
+      for (uint64_t TaxonCounts::* column : {&TaxonCounts::num_orgs, &TaxonCounts::tot_orgs, &TaxonCounts::num_offspring, &TaxonCounts::total_offspring}) {
+        for (uint64_t id : ids) {
+          const uint64_t value = payload.GetVarint();
+          auto it = phylogeny.find(id);
+          if (it != phylogeny.end()) it->second.counts.*column = value;
+        }
+      }
+      if (payload.failed) {
+        ok = false;
+        return false;
+      }
+      found = block_epoch == epoch;
+      return !found;
+    });
+    if (!well_formed || !ok || !found) return false;
+
+    taxa.reserve(phylogeny.size());
+    for (const auto& entry : phylogeny) taxa.emplace_back(entry.second);
+    std::sort(taxa.begin(), taxa.end(), [](const Taxon& a, const Taxon& b) { return a.id < b.id; });
+    // Parents are created before (so have smaller ids than) their offspring.
+    std::unordered_map<uint64_t, size_t> depths;
+    for (Taxon& taxon : taxa) {
+      const auto parent_depth = depths.find(taxon.parent);
+      taxon.depth = (parent_depth == depths.end()) ? 0 : parent_depth->second + 1;
+      depths[taxon.id] = taxon.depth;
+    }
+    return true;
+  }
+
+};
+
+} // namespace dirdevo
+
+#endif // #ifndef DIRECTED_DEVO_UTILITY_PHYLOGENY_LOG_HPP_INCLUDE
@@ -7,11 +7,14 @@
 #define DIRECTED_DEVO_DIRECTED_DEVO_PROBABILISTIC_SCHEDULER_HPP_INCLUDE
 
 #include <algorithm>
+#include <limits>
 #include <numeric>
 
 #include "emp/datastructs/IndexMap.hpp"
 #include "emp/math/Random.hpp"
 
+#include "FenwickWeightMap.hpp"
+
 namespace dirdevo {
 
 /**
@@ -21,10 +24,22 @@ namespace dirdevo {
  *  - (1) The ProbabilisticScheduler will maintain a schedule (of a configured size), and you can use UpdateSchedule calls to update this maintained schedule based on current item weights.
  *    This approach allows you to repeatedly compute chunks of a schedule without constantly creating new vectors.
  *  - (2) Alternatively, just call GetRandom repeatedly each time you need choose something to 'run'.
+ *  - (3) Or, call GetNext, which draws from a batch of pre-drawn items if batching is configured (ConfigureBatching), falling back to GetRandom otherwise.
+ *    Batches are drawn in one pass against the current weights. When weights change part-way through a batch, the batch is kept and
+ *    corrected locally instead of being thrown out: pre-drawn items whose weight fell are thinned (rejected with probability
+ *    (drawn weight - current weight) / drawn weight), and items whose weight rose are drawn in addition to the batch (in proportion to
+ *    how much their weight rose). Served items then follow the current weights, just as GetRandom's would.
+ *    If too many items change before a batch runs out (e.g., SyncSchedulerWeights), the batch is thrown out and redrawn instead.
+ *    Optionally, batches can be sorted by item id (for memory locality); the same corrections apply. Sorted batches serve high ids
+ *    later, though, so when weights change every few draws, high ids' served frequencies lag behind their weights somewhat.
+ *
+ * WEIGHT_MAP determines how item weights are stored and sampled (emp::IndexMap or FenwickWeightMap). See the ProbabilisticScheduler alias below.
  */
-class ProbabilisticScheduler {
+template<typename WEIGHT_MAP>
+class BasicProbabilisticScheduler {
 public:
   using schedule_t = emp::vector<size_t>;
+  using weight_map_t = WEIGHT_MAP;
 
 protected:
 
@@ -32,10 +47,118 @@ protected:
   size_t num_items;
 
   schedule_t schedule;
-  emp::IndexMap weight_map;
+  weight_map_t weight_map;
+
+  static constexpr size_t NO_CHANGE = std::numeric_limits<size_t>::max();
+  static constexpr size_t MAX_BATCH_CHANGES = 32; ///< Redraw the batch if more items than this change weight before it runs out.
+
+  /// An item whose weight changed since the current batch was drawn.
+  struct BatchChange {
+    size_t item;
+    double drawn_weight; ///< Item's weight when the batch was drawn.
+  };
+
+  size_t batch_size=0;      ///< Number of items to draw at a time for GetNext (0 = no batching).
+  bool sort_batch=false;    ///< Sort batches by item id?
+  schedule_t batch;         ///< Items drawn for GetNext.
+  size_t batch_pos=0;       ///< Next position in batch to serve.
+  double batch_weight=0;    ///< Total weight when the batch was drawn.
+  emp::vector<BatchChange> batch_changes; ///< Items whose weight changed since the batch was drawn.
+  emp::vector<size_t> batch_change_slots; ///< Position of each item in batch_changes (NO_CHANGE if its weight hasn't changed).
+  double batch_drop=0;      ///< Total weight lost by changed items since the batch was drawn.
+  double batch_rise=0;      ///< Total weight gained by changed items since the batch was drawn.
+  size_t batch_draws=0;     ///< Items drawn into batches (bookkeeping).
+  size_t batch_discards=0;  ///< Pre-drawn items that were never served: thinned or thrown out with their batch (bookkeeping).
+
+  /// Draw a fresh batch against the current weights.
+  void RefillBatch() {
+    ClearBatchChanges();
+    batch_weight = weight_map.GetWeight();
+    emp_assert(batch_weight > 0);
+    batch.resize(batch_size);
+    for (size_t& item : batch) {
+      item = weight_map.Index(random.GetDouble() * batch_weight);
+    }
+    if (sort_batch) std::sort(batch.begin(), batch.end());
+    batch_pos = 0;
+    batch_draws += batch_size;
+  }
+
+  void ClearBatchChanges() {
+    for (const BatchChange& change : batch_changes) batch_change_slots[change.item] = NO_CHANGE;
+    batch_changes.clear();
+    batch_drop = 0;
+    batch_rise = 0;
+  }
+
+  /// Record that item_id's weight is about to change from old_weight (while a batch is partly served).
+  void TrackBatchChange(size_t item_id, double old_weight, double new_weight) {
+    if (batch_change_slots[item_id] == NO_CHANGE) {
+      if (batch_changes.size() >= MAX_BATCH_CHANGES) {
+        InvalidateBatch();
+        return;
+      }
+      batch_change_slots[item_id] = batch_changes.size();
+      batch_changes.push_back({item_id, old_weight});
+    }
+    // Recompute totals from scratch (there are only a handful of changes) so they don't drift.
+    batch_drop = 0;
+    batch_rise = 0;
+    for (const BatchChange& change : batch_changes) {
+      const double cur_weight = (change.item == item_id) ? new_weight : weight_map.GetWeight(change.item);
+      if (cur_weight < change.drawn_weight) batch_drop += change.drawn_weight - cur_weight;
+      else batch_rise += cur_weight - change.drawn_weight;
+    }
+  }
+
+  /// Thin a drawn item: keep it with probability min(drawn weight, current weight) / (weight it was drawn with), where it was drawn
+  /// either from the batch (drawn weight) or from the current weights.
+  bool KeepItem(size_t item, bool from_batch) {
+    const size_t slot = batch_change_slots[item];
+    if (slot == NO_CHANGE) return true;
+    const double drawn_weight = batch_changes[slot].drawn_weight;
+    const double cur_weight = weight_map.GetWeight(item);
+    const double proposal_weight = (from_batch) ? drawn_weight : cur_weight;
+    const double kept_weight = std::min(drawn_weight, cur_weight);
+    return kept_weight >= proposal_weight || random.GetDouble() * proposal_weight < kept_weight;
+  }
+
+  /// Draw one of the items whose weight rose since the batch was drawn, in proportion to how much it rose.
+  size_t DrawRise() {
+    double target = random.GetDouble() * batch_rise;
+    size_t item = NO_CHANGE;
+    for (const BatchChange& change : batch_changes) {
+      const double rise = weight_map.GetWeight(change.item) - change.drawn_weight;
+      if (rise <= 0) continue;
+      item = change.item;
+      if (target < rise) break;
+      target -= rise;
+    }
+    emp_assert(item != NO_CHANGE);
+    return item;
+  }
+
+  /// GetNext when weights have changed since the batch was drawn.
+  /// Current weights split into what's left of the drawn weights (min(drawn, current) per item) plus the rises. Serve from the
+  /// rises with probability rise / total; otherwise, serve the next pre-drawn item that survives thinning.
+  size_t GetNextCorrected() {
+    double kept_weight = batch_weight - batch_drop;
+    if (kept_weight <= batch_weight * 1e-12) kept_weight = 0; // Every pre-drawn item's weight fell to 0 (up to rounding).
+    if (batch_rise > 0 && random.GetDouble() * (kept_weight + batch_rise) < batch_rise) return DrawRise();
+    while (batch_pos < batch.size()) {
+      const size_t item = batch[batch_pos++];
+      if (KeepItem(item, true)) return item;
+      ++batch_discards;
+    }
+    // Batch ran out mid-correction; finish thinning with fresh draws against the current weights. (The next call refills.)
+    while (true) {
+      const size_t item = GetRandom();
+      if (KeepItem(item, false)) return item;
+    }
+  }
 
 public:
-  ProbabilisticScheduler(
+  BasicProbabilisticScheduler(
     emp::Random & rnd,
     size_t n_items=0,
     size_t schedule_size=0
@@ -43,7 +166,8 @@ public:
     random(rnd),
     num_items(n_items),
     schedule(schedule_size),
-    weight_map(num_items)
+    weight_map(num_items),
+    batch_change_slots(num_items, NO_CHANGE)
   {
     size_t i=0;
     std::generate(
@@ -56,7 +180,7 @@ public:
   size_t GetScheduleSize() const { return schedule.size(); }
   size_t GetNumItems() const { return num_items; }
   const schedule_t & GetCurSchedule() const { return schedule; }
-  const emp::IndexMap & GetWeightMap() const { return weight_map; }
+  const weight_map_t & GetWeightMap() const { return weight_map; }
 
   /// Return a random index where probabilities are weighted according to the weight map.
   size_t GetRandom() {
@@ -64,6 +188,37 @@ public:
     return weight_map.Index(random.GetDouble() * total_weight);
   }
 
+  /// Configure batched draws for GetNext (batch size of 0 disables batching).
+  void ConfigureBatching(size_t size, bool sort=false) {
+    batch_size = size;
+    sort_batch = sort;
+    InvalidateBatch();
+  }
+
+  size_t GetBatchSize() const { return batch_size; }
+
+  /// Number of items drawn into batches so far.
+  size_t GetBatchDraws() const { return batch_draws; }
+
+  /// Number of items drawn into batches that were never served (thinned after a weight drop, or thrown out with their batch).
+  size_t GetBatchDiscards() const { return batch_discards; }
+
+  /// Throw out any remaining pre-drawn items (they'll be redrawn on the next GetNext).
+  void InvalidateBatch() {
+    batch_discards += batch.size() - batch_pos;
+    batch.clear();
+    batch_pos = 0;
+    ClearBatchChanges();
+  }
+
+  /// Return the next item to run: served from a pre-drawn batch if batching is configured, otherwise a fresh random draw.
+  size_t GetNext() {
+    if (!batch_size) return GetRandom();
+    if (batch_pos >= batch.size()) RefillBatch();
+    if (batch_changes.size()) return GetNextCorrected();
+    return batch[batch_pos++];
+  }
+
   /// Update the schedule according to the current weight settings
   const schedule_t & UpdateSchedule() {
     const double total_weight = weight_map.GetWeight();
@@ -85,6 +240,11 @@ public:
 
   /// Adjust the an item's weight in the weight map
   void AdjustWeight(size_t item_id, double new_weight) {
+    // Pre-drawn items need correcting once weights change (see class notes).
+    if (batch_pos < batch.size()) {
+      const double old_weight = weight_map.GetWeight(item_id);
+      if (old_weight != new_weight) TrackBatchChange(item_id, old_weight, new_weight);
+    }
     weight_map.Adjust(item_id, new_weight);
   }
 
@@ -104,6 +264,8 @@ public:
       [this, &i] () mutable { return (i++)%num_items; }
     );
     weight_map.ResizeClear(num_items);
+    InvalidateBatch();
+    batch_change_slots.assign(num_items, NO_CHANGE);
   }
 
   /// Hard reset on the scheduler
@@ -114,6 +276,13 @@ public:
 
 };
 
+// Select the scheduler's weight map backend at compile time.
+#ifdef DIRDEVO_FENWICK_SCHEDULER
+using ProbabilisticScheduler = BasicProbabilisticScheduler<FenwickWeightMap>;
+#else
+using ProbabilisticScheduler = BasicProbabilisticScheduler<emp::IndexMap>;
+#endif // DIRDEVO_FENWICK_SCHEDULER
+
 } // namespace dirdevo
 
 #endif // #ifndef DIRECTED_DEVO_DIRECTED_DEVO_PROBABILISTIC_SCHEDULER_HPP_INCLUDE
\ No newline at end of file
@@ -15,6 +15,7 @@ namespace dirdevo {
 /// TaskSet defines a set of Tasks where each task can be identified by a numeric ID and a string name.
 /// A Task defines a mapping from a given set (vector) of inputs (INPUT_T) to a given output (OUTPUT_T).
 /// This mapping is specified by the task's calc_output_fun, which takes a vector of inputs and maps it to the correct output for the given task.
+/// Tasks may also provide a calc_batch_fun, which computes outputs for many input sets at once (see CalcOutputs).
 template<typename INPUT_T, typename OUTPUT_T>
 class TaskSet {
 
@@ -23,6 +24,8 @@ public:
   using input_t = INPUT_T;
   using output_t = OUTPUT_T;
   using calc_output_fun_t = std::function<output_t(const emp::vector<input_t>&)>;
+  /// Batch calculation: inputs[j][i] is input j of the i'th input set; writes count outputs.
+  using calc_batch_fun_t = std::function<void(const input_t* const* inputs, output_t* outputs, size_t count)>;
 
   struct Task {
     size_t id;          // Task id
@@ -30,19 +33,22 @@ public:
     calc_output_fun_t calc_output_fun;
     size_t num_inputs;
     std::string desc;
+    calc_batch_fun_t calc_batch_fun; // Optional (may be empty)
 
     Task(
       size_t a_id,
       const std::string& a_name,
       const calc_output_fun_t& a_calc_output_fun,
       size_t a_num_inputs,
-      const std::string& a_desc
+      const std::string& a_desc,
+      const calc_batch_fun_t& a_calc_batch_fun=nullptr
     ) :
       id(a_id),
       name(a_name),
       calc_output_fun(a_calc_output_fun),
       num_inputs(a_num_inputs),
-      desc(a_desc)
+      desc(a_desc),
+      calc_batch_fun(a_calc_batch_fun)
      { ; }
 
   };
@@ -80,7 +86,8 @@ public:
     const std::string& name,
     const calc_output_fun_t& calc_output_fun,
     size_t num_inputs,
-    const std::string& desc =""
+    const std::string& desc ="",
+    const calc_batch_fun_t& calc_batch_fun=nullptr
   ) {
     const size_t id = task_lib.size();
     task_lib.emplace_back(
@@ -88,11 +95,28 @@ public:
       name,
       calc_output_fun,
       num_inputs,
-      desc
+      desc,
+      calc_batch_fun
     );
     name_map[name] = id;
   }
 
+  /// Calculate the given task's outputs for count input sets, where inputs[j] points to the j'th input of every input set
+  /// (i.e., inputs[j][i] is input j of input set i). Uses the task's batch function if it has one; otherwise, falls back
+  /// to calling calc_output_fun on each input set.
+  void CalcOutputs(size_t task_id, const input_t* const* inputs, output_t* outputs, size_t count) const {
+    const Task& task = task_lib[task_id];
+    if (task.calc_batch_fun) {
+      task.calc_batch_fun(inputs, outputs, count);
+      return;
+    }
+    emp::vector<input_t> input_set(task.num_inputs);
+    for (size_t i = 0; i < count; ++i) {
+      for (size_t j = 0; j < task.num_inputs; ++j) input_set[j] = inputs[j][i];
+      outputs[i] = task.calc_output_fun(input_set);
+    }
+  }
+
   /// Reset the task set.
   void Clear() {
     task_lib.clear();
@@ -0,0 +1,131 @@
+/**
+ * @file ThreadPool.hpp
+ * @brief A long-lived pool of worker threads used to run worlds (or any other independent jobs) in parallel.
+ *
+ * Threads are created once (when the pool is constructed) and reused for every batch of jobs, which avoids paying for
+ * thread creation every epoch and lets the number of threads be decoupled from the number of jobs.
+ */
+
+#pragma once
+#ifndef DIRECTED_DEVO_UTILITY_THREAD_POOL_HPP_INCLUDE
+#define DIRECTED_DEVO_UTILITY_THREAD_POOL_HPP_INCLUDE
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/vector.hpp"
+
+namespace dirdevo {
+
+/// ThreadPool manages a fixed set of worker threads that pull jobs off of a shared queue.
+/// - The thread that calls Wait (or ParallelFor) helps run queued jobs, so a pool configured for N threads spawns N-1 workers.
+/// - Jobs must not throw.
+class ThreadPool {
+public:
+  using job_t = std::function<void(void)>;
+
+protected:
+  emp::vector<std::thread> workers;   ///< Worker threads (does not include the calling thread).
+  std::deque<job_t> jobs;             ///< Jobs waiting to be run.
+  std::mutex jobs_mutex;              ///< Guards jobs, num_unfinished, and stopping.
+  std::condition_variable job_ready_cv;  ///< Signaled when a new job is queued (or when the pool is stopping).
+  std::condition_variable jobs_done_cv;  ///< Signaled when the number of unfinished jobs hits zero.
+  size_t num_unfinished=0;            ///< Number of jobs that have been submitted but have not finished running.
+  bool stopping=false;                ///< Set when the pool is being destroyed.
+
+  /// Run one job, and let waiting threads know if that was the last unfinished job.
+  void RunJob(job_t& job) {
+    job();
+    std::lock_guard<std::mutex> lock(jobs_mutex);
+    --num_unfinished;
+    if (!num_unfinished) jobs_done_cv.notify_all();
+  }
+
+  /// Worker thread loop: wait for jobs, run them, repeat until the pool is stopped.
+  void WorkerLoop() {
+    while (true) {
+      job_t job;
+      {
+        std::unique_lock<std::mutex> lock(jobs_mutex);
+        job_ready_cv.wait(lock, [this]() { return stopping || !jobs.empty(); });
+        if (stopping && jobs.empty()) return;
+        job = std::move(jobs.front());
+        jobs.pop_front();
+      }
+      RunJob(job);
+    }
+  }
+
+public:
+
+  /// Create a pool that runs jobs on num_threads threads (including the thread that waits on the pool).
+  /// If num_threads is 0, use the number of hardware threads available.
+  explicit ThreadPool(size_t num_threads=0) {
+    if (!num_threads) num_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    workers.reserve(num_threads-1);
+    for (size_t i = 1; i < num_threads; ++i) {
+      workers.emplace_back([this]() { WorkerLoop(); });
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(jobs_mutex);
+      stopping = true;
+    }
+    job_ready_cv.notify_all();
+    for (auto& worker : workers) worker.join();
+  }
+
+  /// How many threads (including the waiting thread) run jobs?
+  size_t GetNumThreads() const { return workers.size() + 1; }
+
+  /// Queue up a job. Jobs do not start running on the calling thread until Wait is called.
+  void Submit(job_t job) {
+    {
+      std::lock_guard<std::mutex> lock(jobs_mutex);
+      jobs.emplace_back(std::move(job));
+      ++num_unfinished;
+    }
+    job_ready_cv.notify_one();
+  }
+
+  /// Block until all submitted jobs have finished. The calling thread runs queued jobs while it waits.
+  void Wait() {
+    while (true) {
+      job_t job;
+      {
+        std::unique_lock<std::mutex> lock(jobs_mutex);
+        if (jobs.empty()) {
+          jobs_done_cv.wait(lock, [this]() { return num_unfinished == 0; });
+          return;
+        }
+        job = std::move(jobs.front());
+        jobs.pop_front();
+      }
+      RunJob(job);
+    }
+  }
+
+  /// Run fun(i) for each i in [0, count) across the pool, returning once every call has finished.
+  void ParallelFor(size_t count, const std::function<void(size_t)>& fun) {
+    for (size_t i = 0; i < count; ++i) {
+      Submit([&fun, i]() { fun(i); });
+    }
+    Wait();
+  }
+
+};
+
+} // namespace dirdevo
+
+#endif // #ifndef DIRECTED_DEVO_UTILITY_THREAD_POOL_HPP_INCLUDE
@@ -0,0 +1,218 @@
+/**
+ * @file WorkStealingExecutor.hpp
+ * @brief Runs sequences of chunked work across a fixed set of threads, letting idle threads steal work from busy ones.
+ *
+ * A "sequence" is an ordered chain of chunks (e.g., a world's epoch split into blocks of updates).
+ * Chunks from the same sequence always run one at a time and in order, but consecutive chunks may run on different threads.
+ */
+
+#pragma once
+#ifndef DIRECTED_DEVO_UTILITY_WORK_STEALING_EXECUTOR_HPP_INCLUDE
+#define DIRECTED_DEVO_UTILITY_WORK_STEALING_EXECUTOR_HPP_INCLUDE
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "emp/base/assert.hpp"
+#include "emp/base/Ptr.hpp"
+#include "emp/base/vector.hpp"
+
+namespace dirdevo {
+
+/// WorkStealingExecutor keeps one double-ended queue of sequence ids per thread.
+/// - Threads run chunks from the back of their own queue and steal from the front of other threads' queues when they run dry.
+/// - After a thread runs a chunk, it pushes the sequence back onto its own queue if the sequence has more chunks.
+/// - Threads with nothing to run or steal sleep until a sequence is pushed back onto a queue or the batch finishes.
+/// - The thread that calls Run participates as thread 0, so an executor configured for N threads spawns N-1 workers.
+class WorkStealingExecutor {
+public:
+  /// Runs the next chunk of the given sequence; returns true if the sequence has more chunks to run.
+  using chunk_fun_t = std::function<bool(size_t)>;
+
+  /// Bookkeeping for a single Run call.
+  struct RunStats {
+    size_t chunks=0;  ///< Total number of chunks run.
+    size_t steals=0;  ///< Number of chunks a thread took from the front of another thread's queue.
+  };
+
+protected:
+
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<size_t> seqs;
+  };
+
+  emp::vector<std::thread> workers;           ///< Worker threads (thread ids 1..N-1).
+  emp::vector<emp::Ptr<WorkQueue>> queues;    ///< One queue per thread (thread id 0 is the caller).
+
+  std::mutex batch_mutex;
+  std::condition_variable batch_start_cv;     ///< Signaled when a new batch of sequences is ready (or the executor is stopping).
+  std::condition_variable batch_done_cv;      ///< Signaled when a worker leaves a batch.
+  size_t batch_id=0;                          ///< Incremented each time Run is called.
+  size_t active_workers=0;                    ///< Number of workers currently participating in a batch.
+  bool stopping=false;
+
+  const chunk_fun_t* cur_fun=nullptr;         ///< Chunk function for the current batch (valid only during Run).
+  std::atomic<size_t> remaining_seqs{0};      ///< Sequences in the current batch that have not finished.
+  std::atomic<size_t> queued_seqs{0};         ///< Sequences currently sitting in a queue (i.e., not running).
+  std::mutex idle_mutex;
+  std::condition_variable idle_cv;            ///< Signaled when a sequence is queued or the last sequence in the batch finishes.
+  std::atomic<size_t> chunk_count{0};
+  std::atomic<size_t> steal_count{0};
+
+  /// Grab a sequence for thread_id: own queue first (LIFO), then steal from others (FIFO).
+  bool Acquire(size_t thread_id, size_t& seq, bool& stolen) {
+    {
+      WorkQueue& own = *queues[thread_id];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.seqs.empty()) {
+        seq = own.seqs.back();
+        own.seqs.pop_back();
+        --queued_seqs;
+        stolen = false;
+        return true;
+      }
+    }
+    const size_t num_queues = queues.size();
+    for (size_t offset = 1; offset < num_queues; ++offset) {
+      WorkQueue& victim = *queues[(thread_id + offset) % num_queues];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.seqs.empty()) {
+        seq = victim.seqs.front();
+        victim.seqs.pop_front();
+        --queued_seqs;
+        stolen = true;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Wake idle threads after changing queued_seqs or remaining_seqs. Taking idle_mutex (even briefly) orders the change
+  /// before a waiting thread's next predicate check, so wakeups can't be lost.
+  void NotifyIdle(bool all) {
+    { std::lock_guard<std::mutex> lock(idle_mutex); }
+    if (all) idle_cv.notify_all();
+    else idle_cv.notify_one();
+  }
+
+  /// Run chunks on thread_id until every sequence in the current batch is finished.
+  void Work(size_t thread_id) {
+    size_t seq=0;
+    bool stolen=false;
+    while (remaining_seqs.load() > 0) {
+      if (!Acquire(thread_id, seq, stolen)) {
+        // Everything left is currently running on other threads; sleep until one of them queues or finishes a sequence.
+        std::unique_lock<std::mutex> lock(idle_mutex);
+        idle_cv.wait(lock, [this]() { return remaining_seqs.load() == 0 || queued_seqs.load() > 0; });
+        continue;
+      }
+      const bool more = (*cur_fun)(seq);
+      ++chunk_count;
+      if (stolen) ++steal_count;
+      if (more) {
+        {
+          WorkQueue& own = *queues[thread_id];
+          std::lock_guard<std::mutex> lock(own.mutex);
+          own.seqs.emplace_back(seq);
+          ++queued_seqs;
+        }
+        NotifyIdle(false);
+      } else if (--remaining_seqs == 0) {
+        NotifyIdle(true);
+      }
+    }
+  }
+
+  void WorkerLoop(size_t thread_id) {
+    size_t last_batch=0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(batch_mutex);
+        batch_start_cv.wait(lock, [this, last_batch]() { return stopping || batch_id != last_batch; });
+        if (stopping) return;
+        last_batch = batch_id;
+        ++active_workers;
+      }
+      Work(thread_id);
+      {
+        std::lock_guard<std::mutex> lock(batch_mutex);
+        --active_workers;
+      }
+      batch_done_cv.notify_all();
+    }
+  }
+
+public:
+
+  /// Create an executor that uses num_threads threads (including the caller). If num_threads is 0, use all hardware threads.
+  explicit WorkStealingExecutor(size_t num_threads=0) {
+    if (!num_threads) num_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    for (size_t i = 0; i < num_threads; ++i) {
+      queues.emplace_back(emp::NewPtr<WorkQueue>());
+    }
+    for (size_t i = 1; i < num_threads; ++i) {
+      workers.emplace_back([this, i]() { WorkerLoop(i); });
+    }
+  }
+
+  WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+  WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+  ~WorkStealingExecutor() {
+    {
+      std::lock_guard<std::mutex> lock(batch_mutex);
+      stopping = true;
+    }
+    batch_start_cv.notify_all();
+    for (auto& worker : workers) worker.join();
+    for (auto queue : queues) queue.Delete();
+  }
+
+  size_t GetNumThreads() const { return queues.size(); }
+
+  /// Run every sequence in [0, num_seqs) to completion, calling fun(seq_id) once per chunk.
+  /// Sequences are initially dealt out round-robin across threads.
+  RunStats Run(size_t num_seqs, const chunk_fun_t& fun) {
+    if (!num_seqs) return {};
+    chunk_count = 0;
+    steal_count = 0;
+    remaining_seqs = num_seqs;
+    queued_seqs = num_seqs;
+    cur_fun = &fun;
+    for (size_t seq = 0; seq < num_seqs; ++seq) {
+      WorkQueue& queue = *queues[seq % queues.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.seqs.emplace_back(seq);
+    }
+    {
+      std::lock_guard<std::mutex> lock(batch_mutex);
+      ++batch_id;
+    }
+    batch_start_cv.notify_all();
+    Work(0);
+    {
+      // Don't return until every worker has stopped touching cur_fun.
+      std::unique_lock<std::mutex> lock(batch_mutex);
+      batch_done_cv.wait(lock, [this]() { return active_workers == 0; });
+    }
+    cur_fun = nullptr;
+    return {chunk_count.load(), steal_count.load()};
+  }
+
+  /// Run fun(i) for each i in [0, count) (each call is a single-chunk sequence).
+  void ParallelFor(size_t count, const std::function<void(size_t)>& fun) {
+    Run(count, [&fun](size_t i) { fun(i); return false; });
+  }
+
+};
+
+} // namespace dirdevo
+
+#endif // #ifndef DIRECTED_DEVO_UTILITY_WORK_STEALING_EXECUTOR_HPP_INCLUDE
@@ -0,0 +1,47 @@
+/**
+ * @file ZobristHash.hpp
+ * @brief Zobrist-style genome hashes that can be updated incrementally from a MutationDelta.
+ */
+
+#pragma once
+#ifndef DIRECTED_DEVO_UTILITY_ZOBRIST_HASH_HPP_INCLUDE
+#define DIRECTED_DEVO_UTILITY_ZOBRIST_HASH_HPP_INCLUDE
+
+#include <cstddef>
+#include <cstdint>
+
+#include "GenomeInternTable.hpp"
+#include "MutationDelta.hpp"
+
+namespace dirdevo {
+
+/// Key for value at site. MixHash64 is a bijection, so every (site, value) pair (site < 2^32) gets a distinct key.
+inline uint64_t ZobristFieldKey(size_t site, uint32_t value) {
+  return MixHash64((((uint64_t)site << 32) | value) ^ 0x6a09e667f3bcc909ULL);
+}
+
+/// Zobrist hash of a genome: the XOR of every field's key (plus the genome's size).
+/// Because each field contributes independently, a substitution updates the hash in O(1) (see UpdateZobristHash).
+/// GENOME must have a GenomeFields specialization that also provides static size_t GetNumSites(const GENOME&).
+template<typename GENOME>
+uint64_t ZobristHash(const GENOME& genome) {
+  using fields_t = GenomeFields<GENOME>;
+  const size_t num_sites = fields_t::GetNumSites(genome);
+  uint64_t hash = MixHash64(num_sites);
+  for (size_t site = 0; site < num_sites; ++site) {
+    hash ^= ZobristFieldKey(site, fields_t::Get(genome, site));
+  }
+  return hash;
+}
+
+/// Hash of the genome that results from applying delta to a genome whose hash is hash. O(delta.size()).
+inline uint64_t UpdateZobristHash(uint64_t hash, const MutationDelta& delta) {
+  for (const auto& edit : delta) {
+    hash ^= ZobristFieldKey(edit.site, edit.old_value) ^ ZobristFieldKey(edit.site, edit.new_value);
+  }
+  return hash;
+}
+
+} // namespace dirdevo
+
+#endif // #ifndef DIRECTED_DEVO_UTILITY_ZOBRIST_HASH_HPP_INCLUDE
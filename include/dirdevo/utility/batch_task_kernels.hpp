@@ -0,0 +1,40 @@
+#pragma once
+#ifndef DIRECTED_DEVO_UTILITY_BATCH_TASK_KERNELS_HPP_INCLUDE
+#define DIRECTED_DEVO_UTILITY_BATCH_TASK_KERNELS_HPP_INCLUDE
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dirdevo {
+
+/// Batch kernels apply a one- or two-input function to count inputs stored in contiguous arrays (one array per input).
+/// They're plain loops over restrict-qualified arrays: with the op inlined (pass a lambda, not a function pointer), GCC
+/// and Clang auto-vectorize them at -O3 (e.g., SSE/AVX on x86, WASM SIMD for web builds).
+namespace batch {
+
+template<typename IN_T, typename OUT_T, typename OP_T>
+void Apply1(OP_T op, const IN_T* __restrict a, OUT_T* __restrict out, size_t count) {
+  for (size_t i = 0; i < count; ++i) out[i] = (OUT_T)op(a[i]);
+}
+
+template<typename IN_T, typename OUT_T, typename OP_T>
+void Apply2(OP_T op, const IN_T* __restrict a, const IN_T* __restrict b, OUT_T* __restrict out, size_t count) {
+  for (size_t i = 0; i < count; ++i) out[i] = (OUT_T)op(a[i], b[i]);
+}
+
+/// Boolean logic tasks operate on 32-bit values (inputs are truncated to uint32_t, as in the scalar task functions).
+template<typename IN_T, typename OUT_T, typename OP_T>
+void ApplyLogic1(OP_T op, const IN_T* __restrict a, OUT_T* __restrict out, size_t count) {
+  for (size_t i = 0; i < count; ++i) out[i] = (OUT_T)op((uint32_t)a[i]);
+}
+
+template<typename IN_T, typename OUT_T, typename OP_T>
+void ApplyLogic2(OP_T op, const IN_T* __restrict a, const IN_T* __restrict b, OUT_T* __restrict out, size_t count) {
+  for (size_t i = 0; i < count; ++i) out[i] = (OUT_T)op((uint32_t)a[i], (uint32_t)b[i]);
+}
+
+} // end batch namespace
+
+} // end dirdevo namespace
+
+#endif // #ifndef DIRECTED_DEVO_UTILITY_BATCH_TASK_KERNELS_HPP_INCLUDE
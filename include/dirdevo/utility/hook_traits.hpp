@@ -0,0 +1,55 @@
+#pragma once
+#ifndef DIRECTED_DEVO_UTILITY_HOOK_TRAITS_HPP_INCLUDE
+#define DIRECTED_DEVO_UTILITY_HOOK_TRAITS_HPP_INCLUDE
+
+#include <type_traits>
+
+namespace dirdevo {
+
+template<typename DERIVED_T, typename ORG_T> class BaseTask;
+template<typename DERIVED_T> class BaseOrganism;
+
+/// Which class does a member function pointer type belong to?
+template<typename MEM_FUN_T> struct MemberFunctionClass;
+
+template<typename CLASS_T, typename RETURN_T, typename... ARGS>
+struct MemberFunctionClass<RETURN_T (CLASS_T::*)(ARGS...)> { using type = CLASS_T; };
+
+template<typename CLASS_T, typename RETURN_T, typename... ARGS>
+struct MemberFunctionClass<RETURN_T (CLASS_T::*)(ARGS...) const> { using type = CLASS_T; };
+
+/// Is the member function (pointer type) MEM_FUN_T declared by BASE_T? I.e., did derived classes leave BASE_T's default in place?
+template<typename MEM_FUN_T, typename BASE_T>
+constexpr bool IsInheritedHook = std::is_same<typename MemberFunctionClass<MEM_FUN_T>::type, BASE_T>::value;
+
+/// Which per-organism event hooks does TASK_T implement? (Hooks left as BaseTask's no-op defaults are skipped by the world at compile time.)
+/// NOTE - hooks must not be overloaded in derived tasks (taking the address of an overloaded member function is ambiguous).
+template<typename TASK_T>
+struct TaskHookTraits {
+  using base_t = BaseTask<TASK_T, typename TASK_T::org_t>;
+  static constexpr bool on_org_inject_ready = !IsInheritedHook<decltype(&TASK_T::OnOrgInjectReady), base_t>;
+  static constexpr bool on_before_org_repro = !IsInheritedHook<decltype(&TASK_T::OnBeforeOrgRepro), base_t>;
+  static constexpr bool on_offspring_ready = !IsInheritedHook<decltype(&TASK_T::OnOffspringReady), base_t>;
+  static constexpr bool on_org_placement = !IsInheritedHook<decltype(&TASK_T::OnOrgPlacement), base_t>;
+  static constexpr bool before_org_process_step = !IsInheritedHook<decltype(&TASK_T::BeforeOrgProcessStep), base_t>;
+  static constexpr bool after_org_process_step = !IsInheritedHook<decltype(&TASK_T::AfterOrgProcessStep), base_t>;
+  static constexpr bool org_steps_remaining = !IsInheritedHook<decltype(&TASK_T::GetOrgStepsRemaining), base_t>;
+  static constexpr bool on_org_death = !IsInheritedHook<decltype(&TASK_T::OnOrgDeath), base_t>;
+  static constexpr bool after_org_swap = !IsInheritedHook<decltype(&TASK_T::AfterOrgSwap), base_t>;
+};
+
+/// Which event hooks does ORG_T implement? (Hooks left as BaseOrganism's no-op defaults are skipped by the world at compile time.)
+template<typename ORG_T>
+struct OrganismHookTraits {
+  using base_t = BaseOrganism<ORG_T>;
+  static constexpr bool on_inject_ready = !IsInheritedHook<decltype(&ORG_T::OnInjectReady), base_t>;
+  static constexpr bool on_before_repro = !IsInheritedHook<decltype(&ORG_T::OnBeforeRepro), base_t>;
+  static constexpr bool on_offspring_ready = !IsInheritedHook<decltype(&ORG_T::OnOffspringReady), base_t>;
+  static constexpr bool on_placement = !IsInheritedHook<decltype(&ORG_T::OnPlacement), base_t>;
+  static constexpr bool on_birth = !IsInheritedHook<decltype(&ORG_T::OnBirth), base_t>;
+  static constexpr bool on_death = !IsInheritedHook<decltype(&ORG_T::OnDeath), base_t>;
+};
+
+} // namespace dirdevo
+
+#endif // #ifndef DIRECTED_DEVO_UTILITY_HOOK_TRAITS_HPP_INCLUDE
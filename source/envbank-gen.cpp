@@ -0,0 +1,57 @@
+//  This file is part of directed-digital-evolution
+//  Copyright (C) Alexander Lalejini, 2021.
+//  Released under MIT license; see LICENSE
+
+#include <filesystem>
+#include <iostream>
+
+#include "emp/math/Random.hpp"
+
+#include "dirdevo/utility/config_setup.hpp"
+#include "dirdevo/DirectedDevoConfig.hpp"
+#include "dirdevo/DirectedDevoWorld.hpp"
+
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPOrganism.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPMultiPathwayTask.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPPeripheral.hpp"
+
+// Prebuilds AvidaGP environment bank files, so experiment runs can memory-map them instead of generating banks at
+// startup. Takes the same configuration as the main executable (config file and command line arguments); writes one bank
+// file per pathway (for the configured AVIDAGP_ENV_FILE, AVIDAGP_ENV_BANK_SIZE, AVIDAGP_UNIQUE_ENV_OUTPUT, and
+// AVIDAGP_ENV_BANK_SEED) into AVIDAGP_ENV_BANK_DIR. Runs configured the same way will find and map these files.
+
+dirdevo::DirectedDevoConfig cfg;
+
+int main(int argc, char* argv[])
+{
+  using org_t = dirdevo::AvidaGPOrganism;
+  using task_t = dirdevo::AvidaGPMultiPathwayTask;
+  using world_t = dirdevo::DirectedDevoWorld<org_t,task_t>;
+
+  setup_config_native(cfg, argc, argv);
+
+  if (cfg.AVIDAGP_ENV_BANK_DIR() == "") {
+    std::cout << "AVIDAGP_ENV_BANK_DIR must be set (where should bank files be written?)." << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (cfg.AVIDAGP_ENV_BANK_SEED() <= 0) {
+    std::cout << "AVIDAGP_ENV_BANK_SEED must be set to a positive seed (bank files are only used for explicitly seeded banks)." << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::filesystem::create_directories(cfg.AVIDAGP_ENV_BANK_DIR());
+
+  // Building a world asks the peripheral for each pathway's bank (mapping existing files, generating the rest).
+  dirdevo::AvidaGPPeripheral peripheral;
+  peripheral.Setup(cfg);
+  emp::Random random(cfg.SEED());
+  world_t world(cfg, random, "envbank_gen", 0, &peripheral);
+
+  const int num_saved = peripheral.SaveEnvironmentBanks();
+  if (num_saved < 0) {
+    std::cout << "Failed to write environment bank files to " << peripheral.GetBankDir() << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Wrote " << num_saved << " environment bank file(s) to " << peripheral.GetBankDir();
+  std::cout << " (" << peripheral.GetNumEnvironmentBanks() - (size_t)num_saved << " already existed)." << std::endl;
+  return 0;
+}
@@ -22,6 +22,7 @@
 #include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPOrganism.hpp"
 #include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPMutator.hpp"
 #include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPMultiPathwayTask.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPPeripheral.hpp"
 
 // This is the main function for the NATIVE version of directed-digital-evolution.
 
@@ -53,7 +54,8 @@ int main(int argc, char* argv[])
   using task_t = dirdevo::AvidaGPMultiPathwayTask;
   using mutator_t = dirdevo::AvidaGPMutator;
   using world_t = dirdevo::DirectedDevoWorld<org_t,task_t>;
-  using experiment_t = dirdevo::DirectedDevoExperiment<world_t, org_t, mutator_t, task_t>;
+  using peripheral_t = dirdevo::AvidaGPPeripheral; // Environment banks are built once and shared by all worlds.
+  using experiment_t = dirdevo::DirectedDevoExperiment<world_t, org_t, mutator_t, task_t, peripheral_t>;
   ///////////////////////////////////////////////////////
 
   // Set up a configuration panel for native application
@@ -0,0 +1,66 @@
+//  This file is part of directed-digital-evolution
+//  Copyright (C) Alexander Lalejini, 2021.
+//  Released under MIT license; see LICENSE
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "dirdevo/utility/PhylogenyLog.hpp"
+
+// Reads an incremental phylogeny log (phylogeny.ddphylo, written when OUTPUT_PHYLOGENY_SNAPSHOT_FORMAT=incremental).
+// - phylogeny-reader <log file>: lists the epochs that have snapshots.
+// - phylogeny-reader <log file> <epoch> [output file]: reconstructs the phylogeny as of that epoch's snapshot and writes
+//   it as CSV (to the output file, or to standard output), with the same columns as the csv snapshot format:
+//   id, ancestor_list, origin_time, destruction_time (inf while the taxon is alive), num_orgs, tot_orgs, num_offspring,
+//   total_offspring, depth, and info (the taxon's genome).
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2 || argc > 4) {
+    std::cout << "Usage: " << argv[0] << " <phylogeny log> [epoch [output.csv]]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const dirdevo::PhylogenyLogReader reader(argv[1]);
+  if (!reader.IsValid()) {
+    std::cout << "Failed to read phylogeny log: " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (argc == 2) {
+    for (size_t epoch : reader.GetEpochs()) std::cout << epoch << std::endl;
+    return 0;
+  }
+
+  const size_t epoch = std::strtoull(argv[2], nullptr, 10);
+  emp::vector<dirdevo::PhylogenyLogReader::Taxon> taxa;
+  if (!reader.Reconstruct(epoch, taxa)) {
+    std::cout << "No snapshot for epoch " << epoch << " in " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ofstream out_file;
+  if (argc == 4) {
+    out_file.open(argv[3]);
+    if (!out_file.is_open()) {
+      std::cout << "Failed to open output file: " << argv[3] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::ostream& out = (argc == 4) ? out_file : std::cout;
+  out << "id,ancestor_list,origin_time,destruction_time,num_orgs,tot_orgs,num_offspring,total_offspring,depth,info\n";
+  for (const auto& taxon : taxa) {
+    out << taxon.id << ",";
+    if (taxon.parent == dirdevo::PhylogenyLogReader::NO_PARENT) out << "[NONE],";
+    else out << "[" << taxon.parent << "],";
+    out << taxon.origin_time << ",";
+    if (taxon.extinct) out << taxon.destruction_time << ",";
+    else out << "inf,";
+    out << taxon.counts.num_orgs << "," << taxon.counts.tot_orgs << ",";
+    out << taxon.counts.num_offspring << "," << taxon.counts.total_offspring << ",";
+    out << taxon.depth << "," << taxon.info << "\n";
+  }
+  return 0;
+}
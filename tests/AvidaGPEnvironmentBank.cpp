@@ -2,15 +2,17 @@
 
 #include "Catch/single_include/catch2/catch.hpp"
 
+#include <algorithm>
+#include <filesystem>
 #include <unordered_set>
 
 #include "emp/math/Random.hpp"
 #include "emp/datastructs/vector_utils.hpp"
-#include "emp/datastructs/map_utils.hpp"
-#include "emp/datastructs/set_utils.hpp"
 
 #include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPTaskSet.hpp"
 #include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPEnvironmentBank.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPPeripheral.hpp"
+#include "dirdevo/DirectedDevoConfig.hpp"
 
 TEST_CASE("L9EnvironmentBank", "[l9]")
 {
@@ -22,21 +24,35 @@ TEST_CASE("L9EnvironmentBank", "[l9]")
   dirdevo::AvidaGPEnvironmentBank env_bank10(random, task_set);
   env_bank10.GenerateBank(10);
   CHECK(env_bank10.GetSize() == 10);
+  CHECK(env_bank10.GetNumTasks() == task_set.GetSize());
   // Is each environment collision-free?
   for (size_t i = 0; i < env_bank10.GetSize(); ++i) {
     auto env = env_bank10.GetEnvironment(i);
-    CHECK(!env.is_collision);
-    CHECK(env.valid_outputs.size() == task_set.GetSize());
+    CHECK(!env.IsCollision());
+    CHECK(env.GetID() == i);
+    const auto input_view = env.GetInputBuffer();
+    const emp::vector<double> input_buffer(input_view.begin(), input_view.end());
+    CHECK(input_buffer.size() == dirdevo::AvidaGPEnvironmentBank::ENV_NUM_INPUTS);
+    std::unordered_set<double> valid_outputs;
     for (size_t task_id = 0; task_id < task_set.GetSize(); ++task_id) {
       auto& task = task_set.GetTask(task_id);
 
       const uint32_t calc_task_output = task.calc_output_fun(
-        (task.num_inputs > 1) ? env.input_buffer : emp::vector<double>({env.input_buffer[0]})
+        (task.num_inputs > 1) ? input_buffer : emp::vector<double>({input_buffer[0]})
       );
-      const uint32_t env_task_output = env.correct_outputs[task_id];
+      const uint32_t env_task_output = env.GetCorrectOutput(task_id);
       CHECK(calc_task_output == env_task_output);
-      CHECK(emp::Has(env.valid_outputs, calc_task_output));
-      CHECK(env.task_lookup[calc_task_output].size() == 1);
+      CHECK(env.IsValidOutput(calc_task_output));
+      CHECK(env.CountTasks(calc_task_output) == 1);
+      CHECK(env.GetTaskID(calc_task_output) == task_id);
+      valid_outputs.emplace(calc_task_output);
+    }
+    CHECK(valid_outputs.size() == task_set.GetSize());
+    // Values that aren't correct outputs for any task shouldn't map to a task.
+    for (double value : {-1.0, 0.5, 4294967296.0}) {
+      if (valid_outputs.count(value)) continue;
+      CHECK(!env.IsValidOutput(value));
+      CHECK(env.GetTaskID(value) == dirdevo::AvidaGPEnvironmentBank::NO_TASK);
     }
   }
 
@@ -44,5 +60,111 @@ TEST_CASE("L9EnvironmentBank", "[l9]")
   dirdevo::AvidaGPEnvironmentBank env_bank10000(random, task_set);
   env_bank10000.GenerateBank(10000);
   CHECK(env_bank10000.GetSize() == 10000);
+  // Environments are stored contiguously: a few hundred bytes each at most.
+  CHECK(env_bank10000.GetMemoryFootprint() < 10000 * (2*sizeof(double) + task_set.GetSize()*(2*sizeof(double)+sizeof(uint16_t)) + 16));
+
+}
+
+TEST_CASE("SharedEnvironmentBanks", "[l9]")
+{
+  dirdevo::DirectedDevoConfig config;
+  config.SEED(2);
+  dirdevo::AvidaGPPeripheral peripheral;
+  peripheral.Setup(config);
+  CHECK(peripheral.SharesEnvironmentBanks());
+
+  // Two worlds' pathways with the same tasks should get the same bank.
+  dirdevo::AvidaGPTaskSet world0_tasks;
+  dirdevo::AvidaGPTaskSet world1_tasks;
+  world0_tasks.AddTasksByName({"ECHO", "NAND"});
+  world1_tasks.AddTasksByName({"ECHO", "NAND"});
+  auto bank0 = peripheral.GetEnvironmentBank(world0_tasks, 100, true);
+  auto bank1 = peripheral.GetEnvironmentBank(world1_tasks, 100, true);
+  CHECK(bank0 == bank1);
+  CHECK(bank0->GetSize() == 100);
+  CHECK(bank0->GetNumTasks() == 2);
+  CHECK(peripheral.GetNumEnvironmentBanks() == 1);
+
+  // Different tasks (or bank settings) get a different bank.
+  dirdevo::AvidaGPTaskSet echo_tasks;
+  echo_tasks.AddTasksByName({"ECHO"});
+  auto bank2 = peripheral.GetEnvironmentBank(echo_tasks, 100, true);
+  auto bank3 = peripheral.GetEnvironmentBank(world0_tasks, 50, true);
+  CHECK(bank2 != bank0);
+  CHECK(bank3 != bank0);
+  CHECK(bank2->GetNumTasks() == 1);
+  CHECK(bank3->GetSize() == 50);
+  CHECK(peripheral.GetNumEnvironmentBanks() == 3);
+}
+
+TEST_CASE("EnvironmentBankFiles", "[l9]")
+{
+  constexpr int64_t seed=2;
+  const std::string path("test-envbank.bin");
+  dirdevo::AvidaGPTaskSet task_set;
+  task_set.AddTasksByName({"ECHO", "NAND", "NOT"});
+  emp::Random random(seed);
+
+  dirdevo::AvidaGPEnvironmentBank generated(random, task_set);
+  generated.GenerateBank(500);
+  const uint64_t key = dirdevo::AvidaGPEnvironmentBank::GetBankKey(task_set, 500, true, seed);
+  REQUIRE(generated.SaveBank(path, key, seed, true));
 
+  // Loaded (mapped) banks should match the generated bank exactly.
+  dirdevo::AvidaGPEnvironmentBank loaded(random, task_set);
+  REQUIRE(loaded.LoadBank(path, key));
+  CHECK(loaded.IsMapped());
+  CHECK(loaded.GetSize() == generated.GetSize());
+  CHECK(loaded.GetNumTasks() == generated.GetNumTasks());
+  for (size_t i = 0; i < generated.GetSize(); ++i) {
+    const auto gen_env = generated.GetEnvironment(i);
+    const auto load_env = loaded.GetEnvironment(i);
+    CHECK(load_env.IsCollision() == gen_env.IsCollision());
+    CHECK(std::equal(gen_env.GetInputBuffer().begin(), gen_env.GetInputBuffer().end(), load_env.GetInputBuffer().begin()));
+    for (size_t task_id = 0; task_id < task_set.GetSize(); ++task_id) {
+      CHECK(load_env.GetCorrectOutput(task_id) == gen_env.GetCorrectOutput(task_id));
+      CHECK(load_env.GetTaskID(gen_env.GetCorrectOutput(task_id)) == gen_env.GetTaskID(gen_env.GetCorrectOutput(task_id)));
+    }
+  }
+
+  // Files don't load under the wrong key or for a different task set.
+  dirdevo::AvidaGPEnvironmentBank wrong_key(random, task_set);
+  CHECK(!wrong_key.LoadBank(path, dirdevo::AvidaGPEnvironmentBank::GetBankKey(task_set, 500, true, seed+1)));
+  CHECK(wrong_key.GetSize() == 0);
+  dirdevo::AvidaGPTaskSet other_tasks;
+  other_tasks.AddTasksByName({"ECHO", "NAND", "AND"});
+  dirdevo::AvidaGPEnvironmentBank wrong_tasks(random, other_tasks);
+  CHECK(!wrong_tasks.LoadBank(path, key));
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("EnvironmentBankGenerationIsThreadCountIndependent", "[l9]")
+{
+  constexpr size_t seed=2;
+  dirdevo::AvidaGPTaskSet task_set;
+  emp::Random random1(seed);
+  emp::Random random4(seed);
+  // Not a multiple of the generation chunk size (so the last chunk is partial).
+  const size_t bank_size = 2*dirdevo::AvidaGPEnvironmentBank::GENERATION_CHUNK_SIZE + 123;
+  dirdevo::AvidaGPEnvironmentBank bank1(random1, task_set);
+  dirdevo::AvidaGPEnvironmentBank bank4(random4, task_set);
+  bank1.GenerateBank(bank_size, true, 1);
+  bank4.GenerateBank(bank_size, true, 4);
+  REQUIRE(bank1.GetSize() == bank_size);
+  REQUIRE(bank4.GetSize() == bank_size);
+  #ifdef DIRDEVO_THREADING
+  REQUIRE(bank4.GetGenerationThreads() > 1); // Make sure the multi-threaded path actually ran (see test-threaded-% in tests/Makefile).
+  #else
+  REQUIRE(bank4.GetGenerationThreads() == 1);
+  #endif // DIRDEVO_THREADING
+  for (size_t i = 0; i < bank_size; ++i) {
+    const auto env1 = bank1.GetEnvironment(i);
+    const auto env4 = bank4.GetEnvironment(i);
+    CHECK(std::equal(env1.GetInputBuffer().begin(), env1.GetInputBuffer().end(), env4.GetInputBuffer().begin()));
+    for (size_t task_id = 0; task_id < task_set.GetSize(); ++task_id) {
+      CHECK(env1.GetCorrectOutput(task_id) == env4.GetCorrectOutput(task_id));
+    }
+  }
+  CHECK(bank1.GetGenerationThroughput() > 0);
 }
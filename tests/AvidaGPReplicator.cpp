@@ -2,6 +2,7 @@
 
 #include "Catch/single_include/catch2/catch.hpp"
 
+#include <algorithm>
 #include <iostream>
 
 #include "emp/math/Random.hpp"
@@ -61,4 +62,125 @@ TEST_CASE("AvidaGPReplicator on AvidaGPL9Task", "[l9]") {
     CHECK(agp_hardware.GetNumFailedSelfDivisions() == 0);
   }
 
-}
\ No newline at end of file
+}
+
+TEST_CASE("Pre-decoded AvidaGPReplicator matches library dispatch", "[l9]") {
+
+  using org_t = dirdevo::AvidaGPOrganism;
+  using task_t = dirdevo::AvidaGPMultiPathwayTask;
+  using world_t = dirdevo::DirectedDevoWorld<org_t,task_t>;
+
+  dirdevo::DirectedDevoConfig config;
+  config.SEED(2);
+  config.AVIDAGP_ENV_FILE("example-environment.json");
+  emp::Random random(config.SEED());
+  world_t world(config, random);
+  const auto& task = world.GetTask();
+  REQUIRE(task.GetOpcodeTable().IsComplete());
+
+  const size_t num_pathways = task.GetNumPathways();
+  const emp::vector<double> inputs({3, 5, 7, 11, 13});
+
+  // Run random programs on both engines in lockstep; all observable hardware state should match after every step.
+  for (size_t program = 0; program < 100; ++program) {
+    dirdevo::AvidaGPReplicator library_hw(task.GetInstLib());
+    library_hw.PushRandom(random, 100);
+    library_hw.ResetReplicatorHardware(num_pathways);
+    for (size_t pathway_id = 0; pathway_id < num_pathways; ++pathway_id) {
+      library_hw.BindEnvironment(pathway_id, 0, inputs);
+    }
+    dirdevo::AvidaGPReplicator decoded_hw(library_hw);
+    decoded_hw.SetOpcodeTable(&task.GetOpcodeTable());
+    REQUIRE(decoded_hw.IsDecoding());
+
+    for (size_t step = 0; step < 1000; ++step) {
+      library_hw.SingleProcess();
+      decoded_hw.Step();
+      REQUIRE(library_hw.GetIP() == decoded_hw.GetIP());
+      REQUIRE(library_hw.regs == decoded_hw.regs);
+      REQUIRE(library_hw.GetSitesCopied() == decoded_hw.GetSitesCopied());
+      REQUIRE(library_hw.IsDividing() == decoded_hw.IsDividing());
+      for (size_t pathway_id = 0; pathway_id < num_pathways; ++pathway_id) {
+        auto& library_out = library_hw.GetOutputBuffer(pathway_id);
+        auto& decoded_out = decoded_hw.GetOutputBuffer(pathway_id);
+        REQUIRE(std::equal(library_out.begin(), library_out.end(), decoded_out.begin(), decoded_out.end()));
+        library_out.clear();
+        decoded_out.clear();
+      }
+    }
+  }
+
+}
+
+TEST_CASE("AvidaGPMutator birth deltas reproduce offspring genomes", "[l9]") {
+
+  using org_t = dirdevo::AvidaGPOrganism;
+  using task_t = dirdevo::AvidaGPMultiPathwayTask;
+  using world_t = dirdevo::DirectedDevoWorld<org_t,task_t>;
+  using fields_t = dirdevo::GenomeFields<org_t::genome_t>;
+
+  dirdevo::DirectedDevoConfig config;
+  config.SEED(2);
+  config.AVIDAGP_ENV_FILE("example-environment.json");
+  emp::Random random(config.SEED());
+  world_t world(config, random);
+
+  for (const std::string sampling : {"per-site", "skip"}) {
+    config.MUTATION_SAMPLING(sampling);
+    dirdevo::AvidaGPMutator mutator;
+    dirdevo::AvidaGPMutator::Configure(mutator, config);
+
+    dirdevo::AvidaGPReplicator parent_hw(world.GetTask().GetInstLib());
+    parent_hw.PushRandom(random, 100);
+    const org_t::genome_t& parent = parent_hw.GetGenome();
+    for (size_t birth = 0; birth < 100; ++birth) {
+      org_t offspring(parent);
+      const size_t num_muts = mutator.Mutate(offspring.GetGenome(), random, &offspring.GetBirthDelta());
+      const dirdevo::MutationDelta& delta = offspring.GetBirthDelta();
+      REQUIRE(delta.size() == num_muts);
+      for (const auto& edit : delta) {
+        CHECK(fields_t::Get(parent, edit.site) == edit.old_value);
+        CHECK(fields_t::Get(offspring.GetGenome(), edit.site) == edit.new_value);
+      }
+      org_t::genome_t rebuilt(parent);
+      dirdevo::ApplyMutationEdits(rebuilt, delta.begin(), delta.end());
+      REQUIRE(rebuilt == offspring.GetGenome());
+    }
+  }
+
+}
+
+TEST_CASE("AvidaGPOrganism genome hashes stay in sync through births", "[l9]") {
+
+  using org_t = dirdevo::AvidaGPOrganism;
+  using task_t = dirdevo::AvidaGPMultiPathwayTask;
+  using world_t = dirdevo::DirectedDevoWorld<org_t,task_t>;
+
+  dirdevo::DirectedDevoConfig config;
+  config.SEED(2);
+  config.AVIDAGP_ENV_FILE("example-environment.json");
+  emp::Random random(config.SEED());
+  world_t world(config, random);
+  dirdevo::AvidaGPMutator mutator;
+  dirdevo::AvidaGPMutator::Configure(mutator, config);
+
+  dirdevo::AvidaGPReplicator ancestor_hw(world.GetTask().GetInstLib());
+  ancestor_hw.PushRandom(random, 100);
+  emp::vector<emp::Ptr<org_t>> lineage;
+  lineage.emplace_back(emp::NewPtr<org_t>(ancestor_hw.GetGenome()));
+  lineage.back()->OnInjectReady();
+  for (size_t generation = 0; generation < 200; ++generation) {
+    org_t& parent = *lineage.back();
+    lineage.emplace_back(emp::NewPtr<org_t>(parent.GetGenome()));
+    org_t& offspring = *lineage.back();
+    const size_t num_muts = mutator.Mutate(offspring.GetGenome(), random, &offspring.GetBirthDelta());
+    offspring.OnBirth(parent);
+    REQUIRE(offspring.GetGenomeHash() == dirdevo::ZobristHash(offspring.GetGenome()));
+    if (num_muts && !(offspring.GetGenome() == parent.GetGenome())) {
+      CHECK(offspring.GetGenomeHash() != parent.GetGenomeHash());
+    }
+    CHECK((world_t::CalcSystematicsInfo(offspring) == world_t::CalcSystematicsInfo(parent)) == (offspring.GetGenome() == parent.GetGenome()));
+  }
+  for (auto org : lineage) org.Delete();
+
+}
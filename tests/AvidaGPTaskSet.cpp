@@ -5,6 +5,7 @@
 #include <unordered_set>
 
 #include "emp/datastructs/vector_utils.hpp"
+#include "emp/math/Random.hpp"
 
 #include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPTaskSet.hpp"
 
@@ -42,3 +43,37 @@ TEST_CASE("L9 TaskSet", "[l9][TaskSet]")
   CHECK(echo_task.calc_output_fun({0}) == 0);
 
 }
+
+TEST_CASE("TaskSet batch output calculation", "[l9][TaskSet]")
+{
+  dirdevo::AvidaGPTaskSet task_set;
+  task_set.AddTasksByName({
+    "ECHO", "NOT", "NAND", "OR_NOT", "AND", "OR", "AND_NOT", "NOR", "XOR", "EQU",
+    "MATH_1AA", "MATH_1AB", "MATH_1AC",
+    "MATH_2AA", "MATH_2AB", "MATH_2AC", "MATH_2AD", "MATH_2AE", "MATH_2AF", "MATH_2AG", "MATH_2AH"
+  });
+
+  emp::Random random(2);
+  constexpr size_t count = 257;
+  emp::vector<double> a(count), b(count), outputs(count);
+  for (size_t i = 0; i < count; ++i) {
+    a[i] = random.GetUInt(100000000);
+    b[i] = random.GetUInt(100000000);
+  }
+  const double* inputs[2] = {a.data(), b.data()};
+
+  // Batch outputs should exactly match per-input-set outputs.
+  for (size_t task_id = 0; task_id < task_set.GetSize(); ++task_id) {
+    const auto& task = task_set.GetTask(task_id);
+    REQUIRE(task.calc_batch_fun);
+    task_set.CalcOutputs(task_id, inputs, outputs.data(), count);
+    for (size_t i = 0; i < count; ++i) {
+      CHECK(outputs[i] == task.calc_output_fun({a[i], b[i]}));
+    }
+  }
+
+  // Tasks without a batch function fall back to calc_output_fun.
+  task_set.AddTask("SUM", [](const emp::vector<double>& in) { return in[0] + in[1]; }, 2);
+  task_set.CalcOutputs(task_set.GetID("SUM"), inputs, outputs.data(), count);
+  for (size_t i = 0; i < count; ++i) CHECK(outputs[i] == a[i] + b[i]);
+}
@@ -0,0 +1,79 @@
+#define CATCH_CONFIG_MAIN
+
+#include "Catch/single_include/catch2/catch.hpp"
+
+#include "emp/math/Random.hpp"
+
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPOrganism.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPMultiPathwayTask.hpp"
+
+#include "dirdevo/DirectedDevoWorld.hpp"
+#include "dirdevo/DirectedDevoConfig.hpp"
+
+TEST_CASE("World signals trigger once per birth, injection, and death", "[world]") {
+
+  using org_t = dirdevo::AvidaGPOrganism;
+  using task_t = dirdevo::AvidaGPMultiPathwayTask;
+  using world_t = dirdevo::DirectedDevoWorld<org_t,task_t>;
+
+  dirdevo::DirectedDevoConfig config;
+  config.SEED(2);
+  config.AVIDAGP_ENV_FILE("example-environment.json");
+  emp::Random random(config.SEED());
+  world_t world(config, random);
+  world.SetMutFun([](org_t&, emp::Random&) { return 0; });
+
+  size_t inject_ready=0;
+  size_t before_repro=0;
+  size_t offspring_ready=0;
+  size_t before_placement=0;
+  size_t placement=0;
+  size_t deaths=0;
+  size_t placements_before_handling=0; // Placement signals that arrived before the task had set up the placed organism.
+  world.OnInjectReady([&inject_ready](org_t&) { ++inject_ready; });
+  world.OnBeforeRepro([&before_repro](size_t) { ++before_repro; });
+  world.OnOffspringReady([&offspring_ready](org_t&, size_t) { ++offspring_ready; });
+  world.OnBeforePlacement([&before_placement](org_t&, size_t) { ++before_placement; });
+  world.OnPlacement([&](size_t pos) {
+    ++placement;
+    if (!world.GetOrg(pos).GetHardware().IsDecoding()) ++placements_before_handling;
+  });
+  world.OnOrgDeath([&deaths](size_t) { ++deaths; });
+
+  dirdevo::AvidaGPReplicator ancestor_hw(world.GetTask().GetInstLib());
+  ancestor_hw.PushRandom(random, 100);
+  world.InjectAt(ancestor_hw.GetGenome(), 0);
+  CHECK(inject_ready == 1);
+  CHECK(before_placement == 1);
+  CHECK(placement == 1);
+  CHECK(deaths == 0);
+
+  const size_t num_births = 500;
+  for (size_t birth = 0; birth < num_births; ++birth) {
+    const size_t num_orgs = world.GetNumOrgs();
+    const size_t before_placements = before_placement;
+    const size_t placements = placement;
+    const size_t prev_deaths = deaths;
+    // Any living organism can be a parent.
+    size_t parent_pos = random.GetUInt(world.GetSize());
+    while (!world.IsOccupied(parent_pos)) parent_pos = (parent_pos + 1) % world.GetSize();
+    world.DoBirth(world.GetOrg(parent_pos).GetGenome(), parent_pos);
+    REQUIRE(before_placement == before_placements + 1);
+    REQUIRE(placement == placements + 1);
+    // The offspring either filled an empty position or replaced someone (who died).
+    REQUIRE(deaths - prev_deaths == num_orgs + 1 - world.GetNumOrgs());
+  }
+  CHECK(before_repro == num_births);
+  CHECK(offspring_ready == num_births);
+  CHECK(inject_ready == 1);
+  CHECK(placements_before_handling == 0);
+
+  size_t living_pos = 0;
+  while (!world.IsOccupied(living_pos)) ++living_pos;
+  const size_t prev_deaths = deaths;
+  const size_t num_orgs = world.GetNumOrgs();
+  world.DoDeath({living_pos});
+  CHECK(deaths == prev_deaths + 1);
+  CHECK(world.GetNumOrgs() == num_orgs - 1);
+
+}
@@ -0,0 +1,71 @@
+#define CATCH_CONFIG_MAIN
+
+#include "Catch/single_include/catch2/catch.hpp"
+
+#include <cmath>
+
+#include "emp/base/vector.hpp"
+#include "emp/math/Random.hpp"
+
+#include "dirdevo/utility/FenwickWeightMap.hpp"
+
+
+TEST_CASE("FenwickWeightMap lookups match cumulative weights", "[utility][FenwickWeightMap]")
+{
+  emp::Random random(2);
+  for (size_t num_items : {1, 2, 3, 7, 16, 100}) {
+    dirdevo::FenwickWeightMap weight_map(num_items);
+    emp::vector<double> weights(num_items, 0);
+    CHECK(weight_map.GetSize() == num_items);
+    CHECK(weight_map.GetWeight() == 0);
+
+    for (size_t trial = 0; trial < 1000; ++trial) {
+      // Adjust a weight (sometimes to zero); occasionally do a deferred batch of adjustments.
+      const size_t id = random.GetUInt(num_items);
+      weights[id] = random.P(0.25) ? 0 : random.GetDouble(0, 10);
+      weight_map.Adjust(id, weights[id]);
+      if (random.P(0.05)) {
+        weight_map.DeferRefresh();
+        for (size_t i = 0; i < 5; ++i) {
+          const size_t batch_id = random.GetUInt(num_items);
+          weights[batch_id] = random.GetDouble(0, 10);
+          weight_map.Adjust(batch_id, weights[batch_id]);
+        }
+      }
+
+      double total = 0;
+      for (double w : weights) total += w;
+      REQUIRE(std::abs(weight_map.GetWeight() - total) < 0.000001);
+      if (total == 0) continue;
+
+      // Pick a point away from range boundaries and find the expected item by brute force.
+      const double x = random.GetDouble(total);
+      size_t expected = 0;
+      double cumulative = 0;
+      for (; expected < num_items; ++expected) {
+        if (x < cumulative + weights[expected]) break;
+        cumulative += weights[expected];
+      }
+      if (expected == num_items || std::abs(x - cumulative) < 0.000001) continue;
+      const size_t found = weight_map.Index(x);
+      CHECK(found == expected);
+      CHECK(weight_map.GetWeight(found) > 0);
+    }
+  }
+}
+
+TEST_CASE("FenwickWeightMap never returns zero-weight items", "[utility][FenwickWeightMap]")
+{
+  dirdevo::FenwickWeightMap weight_map(10);
+  weight_map.Adjust(0, 0.1);
+  weight_map.Adjust(9, 0.2);
+  CHECK(weight_map.Index(0) == 0);
+  CHECK(weight_map.Index(0.05) == 0);
+  CHECK(weight_map.Index(0.1) == 9);
+  CHECK(weight_map.Index(0.29999) == 9);
+  weight_map.Adjust(0, 0);
+  CHECK(weight_map.Index(0) == 9);
+  weight_map.ResizeClear(4);
+  CHECK(weight_map.GetSize() == 4);
+  CHECK(weight_map.GetWeight() == 0);
+}
@@ -0,0 +1,45 @@
+#define CATCH_CONFIG_MAIN
+
+#include "Catch/single_include/catch2/catch.hpp"
+
+#include <string>
+
+#include "dirdevo/utility/GenomeInternTable.hpp"
+
+
+TEST_CASE("GenomeInternTable deduplicates and reference counts genomes", "[utility][GenomeInternTable]")
+{
+  dirdevo::GenomeInternTable<std::string> table;
+  using handle_t = typename dirdevo::GenomeInternTable<std::string>::handle_t;
+
+  const handle_t a = table.Intern("ABCD");
+  const handle_t b = table.Intern("ABCE");
+  const handle_t c = table.Intern("ABCD");
+  CHECK(a == c);
+  CHECK(a != b);
+  CHECK(table.GetNumGenomes() == 2);
+  CHECK(table.GetRefCount(a) == 2);
+  CHECK(table.Get(a) == "ABCD");
+  CHECK(table.Get(b) == "ABCE");
+  CHECK(table.GetHash(a) == table.Hash("ABCD"));
+  CHECK(table.Find("ABCE") == b);
+  CHECK(table.Find("XYZ") == table.NO_HANDLE);
+
+  // Genomes stick around until every reference is released.
+  table.Release(a);
+  CHECK(table.GetNumGenomes() == 2);
+  CHECK(table.Find("ABCD") == a);
+  table.Release(c);
+  CHECK(table.GetNumGenomes() == 1);
+  CHECK(table.Find("ABCD") == table.NO_HANDLE);
+
+  // Released handles get recycled.
+  const handle_t d = table.Intern("XYZ");
+  CHECK(d == a);
+  CHECK(table.Get(d) == "XYZ");
+  table.Retain(d);
+  CHECK(table.GetRefCount(d) == 2);
+
+  table.Clear();
+  CHECK(table.GetNumGenomes() == 0);
+}
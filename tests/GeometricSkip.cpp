@@ -0,0 +1,103 @@
+#define CATCH_CONFIG_MAIN
+
+#include "Catch/single_include/catch2/catch.hpp"
+
+#include <cmath>
+
+#include "emp/base/vector.hpp"
+#include "emp/bits/BitSet.hpp"
+#include "emp/math/Random.hpp"
+
+#include "dirdevo/DirectedDevoConfig.hpp"
+#include "dirdevo/mutator/BitSetMutator.hpp"
+#include "dirdevo/mutator/GeometricSkip.hpp"
+
+namespace {
+
+/// Is the observed count within z standard deviations of a binomial(trials, p) mean?
+bool WithinBinomial(size_t count, size_t trials, double p, double z=5.0) {
+  const double mean = trials * p;
+  const double sd = std::sqrt(trials * p * (1 - p));
+  return std::abs((double)count - mean) <= z * sd + 1;
+}
+
+}
+
+TEST_CASE("GeometricSkip hits each site independently with the configured rate", "[mutator]")
+{
+  emp::Random random(1);
+  const size_t num_sites = 50;
+  const size_t trials = 100000;
+
+  for (double rate : {0.01, 0.025, 0.3}) {
+    dirdevo::GeometricSkip skip(rate);
+    emp::vector<size_t> site_hits(num_sites, 0);
+    size_t adjacent_hits = 0;   // Both site 0 and site 1 hit (independence check)
+    size_t first_last_hits = 0; // Both site 0 and the last site hit
+    double total = 0;
+    double total_sq = 0;
+    for (size_t t = 0; t < trials; ++t) {
+      emp::vector<bool> hit(num_sites, false);
+      size_t count = 0;
+      size_t prev = 0;
+      skip.ForEachHit(num_sites, random, [&](size_t site) {
+        REQUIRE(site < num_sites);
+        REQUIRE((count == 0 || site > prev)); // Increasing order, each site at most once
+        prev = site;
+        hit[site] = true;
+        ++site_hits[site];
+        ++count;
+      });
+      adjacent_hits += hit[0] && hit[1];
+      first_last_hits += hit[0] && hit[num_sites - 1];
+      total += count;
+      total_sq += count * count;
+    }
+    for (size_t site = 0; site < num_sites; ++site) {
+      CHECK(WithinBinomial(site_hits[site], trials, rate));
+    }
+    CHECK(WithinBinomial(adjacent_hits, trials, rate * rate));
+    CHECK(WithinBinomial(first_last_hits, trials, rate * rate));
+    // Hits per sequence should be binomial(num_sites, rate).
+    const double mean = total / trials;
+    const double variance = total_sq / trials - mean * mean;
+    CHECK(mean == Approx(num_sites * rate).epsilon(0.02));
+    CHECK(variance == Approx(num_sites * rate * (1 - rate)).epsilon(0.05));
+  }
+
+  SECTION("Rates of 0 and 1") {
+    size_t count = 0;
+    dirdevo::GeometricSkip(0.0).ForEachHit(num_sites, random, [&count](size_t) { ++count; });
+    CHECK(count == 0);
+    dirdevo::GeometricSkip(1.0).ForEachHit(num_sites, random, [&count](size_t) { ++count; });
+    CHECK(count == num_sites);
+  }
+}
+
+TEST_CASE("BitSetMutator flips bits at the same per-site rate in both sampling modes", "[mutator]")
+{
+  constexpr size_t BITS = 64;
+  const size_t trials = 50000;
+  const double rate = 0.02;
+  for (const std::string sampling : {"per-site", "skip"}) {
+    dirdevo::DirectedDevoConfig config;
+    config.BITSET_MUTATOR_PER_SITE_SUBSTITUTION_RATE(rate);
+    config.MUTATION_SAMPLING(sampling);
+    dirdevo::BitSetMutator mutator;
+    dirdevo::BitSetMutator::Configure(mutator, config);
+    emp::Random random(2);
+    emp::vector<size_t> flips(BITS, 0);
+    size_t total_flips = 0;
+    for (size_t t = 0; t < trials; ++t) {
+      emp::BitSet<BITS> bits;
+      total_flips += mutator.Mutate(bits, random);
+      for (size_t i = 0; i < BITS; ++i) flips[i] += bits.Get(i);
+    }
+    size_t counted_flips = 0;
+    for (size_t i = 0; i < BITS; ++i) {
+      CHECK(WithinBinomial(flips[i], trials, rate));
+      counted_flips += flips[i];
+    }
+    CHECK(counted_flips == total_flips);
+  }
+}
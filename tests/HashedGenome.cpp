@@ -0,0 +1,55 @@
+#define CATCH_CONFIG_MAIN
+
+#include "Catch/single_include/catch2/catch.hpp"
+
+#include "emp/base/vector.hpp"
+
+#include "dirdevo/utility/HashedGenome.hpp"
+
+namespace {
+
+using genome_t = emp::vector<int>;
+using hashed_genome_t = dirdevo::HashedGenome<genome_t>;
+
+}
+
+TEST_CASE("HashedGenome views borrow and copies own", "[systematics]")
+{
+  genome_t genome({1, 2, 3});
+  const hashed_genome_t view = hashed_genome_t::View(genome, 42);
+  CHECK(view.IsBorrowed());
+  CHECK(&view.GetGenome() == &genome);
+
+  const hashed_genome_t copy(view);
+  CHECK(!copy.IsBorrowed());
+  CHECK(&copy.GetGenome() != &genome);
+  CHECK(copy.GetGenome() == genome);
+  CHECK(copy.GetHash() == 42);
+
+  // Copies of an owning key share its genome.
+  const hashed_genome_t copy_of_copy(copy);
+  CHECK(&copy_of_copy.GetGenome() == &copy.GetGenome());
+
+  // Changing the viewed genome doesn't affect copies.
+  genome[0] = 7;
+  CHECK(copy.GetGenome() == genome_t({1, 2, 3}));
+
+  hashed_genome_t assigned;
+  CHECK(!assigned.HasGenome());
+  assigned = view;
+  CHECK(!assigned.IsBorrowed());
+  CHECK(assigned.GetGenome() == genome_t({7, 2, 3}));
+}
+
+TEST_CASE("HashedGenome compares hashes before genomes", "[systematics]")
+{
+  const genome_t genome_a({1, 2, 3});
+  const genome_t genome_b({1, 2, 4});
+  const hashed_genome_t a(genome_a, 1);
+  CHECK(a == hashed_genome_t::View(genome_a, 1));
+  CHECK(a != hashed_genome_t::View(genome_b, 2));
+  CHECK(a != hashed_genome_t::View(genome_a, 2)); // Different hash => different, without looking at genomes.
+  CHECK(a != hashed_genome_t::View(genome_b, 1)); // Hash collision => genomes are compared.
+  CHECK(hashed_genome_t() == hashed_genome_t());
+  CHECK(hashed_genome_t() != hashed_genome_t::View(genome_a, 0));
+}
@@ -0,0 +1,103 @@
+#define CATCH_CONFIG_MAIN
+
+#include "Catch/single_include/catch2/catch.hpp"
+
+#include <numeric>
+
+#include "emp/base/vector.hpp"
+#include "emp/bits/BitSet.hpp"
+#include "emp/math/Random.hpp"
+
+#include "dirdevo/DirectedDevoConfig.hpp"
+#include "dirdevo/ExperimentSetups/OneMax/OneMaxLaneWorld.hpp"
+
+namespace {
+
+constexpr size_t BITS = 64;
+using org_t = dirdevo::OneMaxOrganism<BITS>;
+using lane_world_t = dirdevo::OneMaxLaneWorld<BITS>;
+
+/// Just enough world for OneMaxOrganism::ProcessStep.
+struct StepWorld {
+  emp::Random random;
+  StepWorld() : random(1) { ; }
+  emp::Random& GetRandom() { return random; }
+};
+
+}
+
+TEST_CASE("StepOneMaxLanes matches stepping OneMaxOrganisms one at a time", "[OneMax]")
+{
+  emp::Random random(2);
+  StepWorld world;
+  const size_t num_lanes = 200;
+  emp::vector<double> steps(num_lanes), num_ones(num_lanes), resources(num_lanes), ages(num_lanes), births(num_lanes);
+  emp::vector<size_t> expected_births(num_lanes, 0);
+  emp::vector<double> expected_resources(num_lanes);
+
+  for (size_t i = 0; i < num_lanes; ++i) {
+    org_t::genome_t genome;
+    for (size_t bit = 0; bit < BITS; ++bit) genome.Set(bit, random.P(0.5));
+    org_t org(genome);
+    // Give the organism some resources left over from earlier steps.
+    const size_t warmup = random.GetUInt(100);
+    for (size_t s = 0; s < warmup; ++s) {
+      org.ProcessStep(world);
+      if (org.GetReproReady()) org.OnOffspringReady(org);
+    }
+    steps[i] = random.GetUInt(200);
+    num_ones[i] = (double)genome.CountOnes();
+    resources[i] = org.GetResources();
+    ages[i] = warmup;
+    for (size_t s = 0; s < (size_t)steps[i]; ++s) {
+      org.ProcessStep(world);
+      if (org.GetReproReady()) {
+        org.OnOffspringReady(org);
+        ++expected_births[i];
+      }
+    }
+    expected_resources[i] = org.GetResources();
+  }
+
+  dirdevo::StepOneMaxLanes<BITS>(steps.data(), num_ones.data(), resources.data(), ages.data(), births.data(), num_lanes);
+  for (size_t i = 0; i < num_lanes; ++i) {
+    CHECK((size_t)births[i] == expected_births[i]);
+    CHECK(resources[i] == expected_resources[i]);
+    CHECK(resources[i] < org_t::REPRO_RES_THRESHOLD);
+  }
+}
+
+TEST_CASE("OneMaxLaneWorld keeps living organisms packed", "[OneMax]")
+{
+  dirdevo::DirectedDevoConfig config;
+  config.AVG_STEPS_PER_ORG(30);
+  emp::Random random(3);
+  const size_t capacity = 500;
+  lane_world_t world(config, random, capacity);
+
+  world.Inject(org_t::genome_t(false));
+  CHECK(world.GetNumOrgs() == 1);
+  CHECK(world.GetGenome(0).CountOnes() == 0);
+
+  size_t births = 0;
+  for (size_t u = 0; u < 300 && !world.IsExtinct(); ++u) {
+    world.RunStep();
+    REQUIRE(world.GetNumOrgs() <= capacity);
+    for (size_t i = 0; i < world.GetNumOrgs(); ++i) {
+      REQUIRE(world.GetNumOnes(i) == world.GetGenome(i).CountOnes());
+      REQUIRE(world.GetResources(i) < org_t::REPRO_RES_THRESHOLD);
+    }
+    births = world.GetTotalBirths();
+  }
+  CHECK(births > capacity);
+  CHECK(world.GetTotalDeaths() > 0); // Organisms live for ~MAX_AGE steps, so some should have died of old age.
+  REQUIRE(!world.IsExtinct());
+
+  world.Evaluate();
+  const auto& ones_per_position = world.GetOnesPerPosition();
+  const double total_ones = std::accumulate(ones_per_position.begin(), ones_per_position.end(), 0.0);
+  CHECK(total_ones == Approx(world.GetAverageNumOnes() * world.GetNumOrgs()));
+
+  world.Clear();
+  CHECK(world.IsExtinct());
+}
@@ -0,0 +1,69 @@
+#define CATCH_CONFIG_MAIN
+
+#include "Catch/single_include/catch2/catch.hpp"
+
+#include "emp/base/vector.hpp"
+
+#include "dirdevo/utility/OrganismPool.hpp"
+
+namespace {
+
+struct PlainOrg {
+  using genome_t = emp::vector<int>;
+  genome_t genome;
+  size_t age=0;
+  PlainOrg(const genome_t& g) : genome(g) { ; }
+};
+
+struct RecyclingOrg : PlainOrg {
+  size_t times_recycled=0;
+  RecyclingOrg(const genome_t& g) : PlainOrg(g) { ; }
+  void Recycle(const genome_t& g) {
+    genome = g;
+    age = 0;
+    ++times_recycled;
+  }
+};
+
+}
+
+TEST_CASE("OrganismPool reuses released organisms", "[utility][OrganismPool]")
+{
+  static_assert(!dirdevo::HasRecycle<PlainOrg>::value);
+  static_assert(dirdevo::HasRecycle<RecyclingOrg>::value);
+
+  SECTION("Organisms without Recycle are reconstructed in place") {
+    dirdevo::OrganismPool<PlainOrg> pool;
+    auto org = pool.Acquire({1, 2, 3});
+    org->age = 10;
+    PlainOrg* address = org.Raw();
+    pool.Release(org);
+    CHECK(pool.GetSize() == 1);
+    auto recycled = pool.Acquire({4, 5});
+    CHECK(recycled.Raw() == address);
+    CHECK(recycled->genome == PlainOrg::genome_t({4, 5}));
+    CHECK(recycled->age == 0);
+    CHECK(pool.GetSize() == 0);
+    CHECK(pool.GetNumAllocated() == 1);
+    CHECK(pool.GetNumRecycled() == 1);
+    recycled.Delete();
+  }
+
+  SECTION("Organisms with Recycle are recycled (keeping their buffers)") {
+    dirdevo::OrganismPool<RecyclingOrg> pool;
+    auto org = pool.Acquire(RecyclingOrg::genome_t(100, 1));
+    org->age = 10;
+    const size_t capacity = org->genome.capacity();
+    pool.Release(org);
+    auto recycled = pool.Acquire({4, 5});
+    CHECK(recycled->times_recycled == 1);
+    CHECK(recycled->age == 0);
+    CHECK(recycled->genome == RecyclingOrg::genome_t({4, 5}));
+    CHECK(recycled->genome.capacity() == capacity);
+    // Pool owns (and cleans up) anything left in it.
+    pool.Release(recycled);
+    pool.Release(pool.Acquire({6}));
+    pool.Release(emp::NewPtr<RecyclingOrg>(RecyclingOrg::genome_t({7})));
+    CHECK(pool.GetSize() == 2);
+  }
+}
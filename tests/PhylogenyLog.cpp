@@ -0,0 +1,136 @@
+#define CATCH_CONFIG_MAIN
+
+#include "Catch/single_include/catch2/catch.hpp"
+
+#include <cstdio>
+#include <map>
+#include <string>
+
+#include "emp/base/vector.hpp"
+#include "emp/math/Random.hpp"
+
+#include "dirdevo/utility/PhylogenyLog.hpp"
+
+namespace {
+
+using reader_t = dirdevo::PhylogenyLogReader;
+using writer_t = dirdevo::PhylogenyLogWriter;
+
+/// Reference phylogeny: taxon id => (parent, origin time, destruction time or -1 if alive, info, counts).
+struct RefTaxon {
+  uint64_t parent;
+  int64_t origin;
+  int64_t destruction;
+  std::string info;
+  writer_t::TaxonCounts counts;
+};
+using ref_phylogeny_t = std::map<uint64_t, RefTaxon>;
+
+}
+
+TEST_CASE("PhylogenyLogReader reconstructs every snapshot written by PhylogenyLogWriter", "[systematics]")
+{
+  const std::string path = "phylogeny_log_test.ddphylo";
+  emp::Random random(1);
+  writer_t writer;
+
+  ref_phylogeny_t phylogeny;
+  std::map<size_t, ref_phylogeny_t> snapshots;
+  uint64_t next_id = 0;
+  int64_t time = 0;
+
+  auto has_children = [&phylogeny](uint64_t id) {
+    for (const auto& entry : phylogeny) if (entry.second.parent == id) return true;
+    return false;
+  };
+
+  // Changes recorded before the log is opened go into the first block.
+  // Genome-like info of varying length (including empty).
+  auto random_info = [&random]() {
+    std::string info(random.GetUInt(40), ' ');
+    for (char& c : info) c = (char)('a' + random.GetUInt(26));
+    return info;
+  };
+  auto set_counts = [&writer, &phylogeny, &random](uint64_t id) {
+    writer_t::TaxonCounts& counts = phylogeny[id].counts;
+    counts.num_orgs = random.GetUInt(1000);
+    counts.tot_orgs = counts.num_orgs + random.GetUInt(100000);
+    counts.num_offspring = random.GetUInt(5);
+    counts.total_offspring = counts.num_offspring + random.GetUInt(1u << 20);
+    writer.SetTaxonCounts(id, counts);
+  };
+
+  // Changes recorded before the log is opened go into the first block.
+  std::string info = random_info();
+  writer.AddTaxon(next_id, writer_t::NO_PARENT, time, info);
+  phylogeny[next_id++] = {writer_t::NO_PARENT, time, -1, info, {}};
+  set_counts(0);
+  REQUIRE(writer.Open(path));
+
+  for (size_t epoch = 0; epoch < 30; ++epoch) {
+    for (size_t event = 0; event < 50; ++event) {
+      time += random.GetUInt(3);
+      emp::vector<uint64_t> alive;
+      emp::vector<uint64_t> prunable; // Extinct, with no descendants left (as emp::Systematics prunes them)
+      for (const auto& entry : phylogeny) {
+        if (entry.second.destruction < 0) alive.emplace_back(entry.first);
+        else if (!has_children(entry.first)) prunable.emplace_back(entry.first);
+      }
+      const double roll = random.GetDouble();
+      if (roll < 0.5 || alive.empty()) {
+        const uint64_t parent = (alive.empty()) ? writer_t::NO_PARENT : alive[random.GetUInt(alive.size())];
+        info = random_info();
+        writer.AddTaxon(next_id, parent, time, info);
+        phylogeny[next_id] = {parent, time, -1, info, {}};
+        if (random.P(0.5)) set_counts(next_id); // Otherwise, counts stay zero (e.g., a taxon with no organisms yet)
+        ++next_id;
+      } else if (roll < 0.7) {
+        set_counts(alive[random.GetUInt(alive.size())]); // Counts may be set more than once between snapshots.
+      } else if (roll < 0.85) {
+        const uint64_t id = alive[random.GetUInt(alive.size())];
+        writer.SetDestructionTime(id, time);
+        phylogeny[id].destruction = time;
+      } else if (prunable.size()) {
+        const uint64_t id = prunable[random.GetUInt(prunable.size())];
+        writer.RemoveTaxon(id);
+        phylogeny.erase(id);
+      }
+    }
+    if (epoch % 3) continue; // Snapshot every few epochs.
+    REQUIRE(writer.WriteSnapshot(epoch));
+    snapshots[epoch] = phylogeny;
+  }
+  writer.Close();
+
+  const reader_t reader(path);
+  REQUIRE(reader.IsValid());
+  const emp::vector<size_t> epochs = reader.GetEpochs();
+  REQUIRE(epochs.size() == snapshots.size());
+
+  emp::vector<reader_t::Taxon> taxa;
+  for (size_t epoch : epochs) {
+    REQUIRE(snapshots.count(epoch));
+    const ref_phylogeny_t& expected = snapshots[epoch];
+    REQUIRE(reader.Reconstruct(epoch, taxa));
+    REQUIRE(taxa.size() == expected.size());
+    for (const auto& taxon : taxa) {
+      REQUIRE(expected.count(taxon.id));
+      const RefTaxon& ref = expected.at(taxon.id);
+      CHECK(taxon.parent == ref.parent);
+      CHECK(taxon.origin_time == ref.origin);
+      CHECK(taxon.extinct == (ref.destruction >= 0));
+      if (taxon.extinct) CHECK(taxon.destruction_time == ref.destruction);
+      size_t depth = 0;
+      for (uint64_t parent = ref.parent; parent != writer_t::NO_PARENT; parent = expected.at(parent).parent) ++depth;
+      CHECK(taxon.depth == depth);
+      CHECK(taxon.info == ref.info);
+      CHECK(taxon.counts.num_orgs == ref.counts.num_orgs);
+      CHECK(taxon.counts.tot_orgs == ref.counts.tot_orgs);
+      CHECK(taxon.counts.num_offspring == ref.counts.num_offspring);
+      CHECK(taxon.counts.total_offspring == ref.counts.total_offspring);
+    }
+  }
+  CHECK(!reader.Reconstruct(1, taxa)); // No snapshot for epoch 1
+
+  std::remove(path.c_str());
+}
@@ -0,0 +1,148 @@
+#define CATCH_CONFIG_MAIN
+
+#include "Catch/single_include/catch2/catch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <tuple>
+
+#include "emp/base/Ptr.hpp"
+#include "emp/base/vector.hpp"
+#include "emp/math/Random.hpp"
+
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPOrganism.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPMultiPathwayTask.hpp"
+#include "dirdevo/ExperimentSetups/AvidaGP/AvidaGPMutator.hpp"
+
+#include "dirdevo/DirectedDevoWorld.hpp"
+#include "dirdevo/DirectedDevoConfig.hpp"
+
+namespace {
+
+using org_t = dirdevo::AvidaGPOrganism;
+using task_t = dirdevo::AvidaGPMultiPathwayTask;
+using world_t = dirdevo::DirectedDevoWorld<org_t,task_t>;
+using systematics_t = world_t::systematics_t;
+using taxon_t = world_t::taxon_t;
+
+/// (id, parent id, origination time, number of organisms, genome hash) for one taxon.
+using taxon_record_t = std::tuple<size_t, size_t, double, size_t, uint64_t>;
+
+constexpr size_t NUM_WORLDS = 3;
+constexpr size_t NUM_EPOCHS = 3;
+constexpr size_t WORLD_SEED = 7;
+
+/// Worlds that share a systematics manager, mirroring how the experiment sets them up.
+struct SharedSystematicsRun {
+  dirdevo::DirectedDevoConfig& config;
+  systematics_t systematics;
+  emp::vector<emp::Ptr<emp::Random>> rngs;
+  emp::vector<dirdevo::AvidaGPMutator> mutators;
+  emp::vector<emp::Ptr<world_t>> worlds;
+
+  SharedSystematicsRun(dirdevo::DirectedDevoConfig& cfg, bool flush_on_update)
+    : config(cfg), systematics(world_t::CalcSystematicsInfo), mutators(NUM_WORLDS)
+  {
+    systematics.SetTrackSynchronous(false);
+    for (size_t i = 0; i < NUM_WORLDS; ++i) {
+      rngs.emplace_back(emp::NewPtr<emp::Random>(WORLD_SEED + i));
+      dirdevo::AvidaGPMutator::Configure(mutators[i], config);
+      worlds.emplace_back(emp::NewPtr<world_t>(config, *rngs[i], "world_"+emp::to_string(i), i));
+    }
+    for (size_t i = 0; i < NUM_WORLDS; ++i) {
+      world_t& world = *worlds[i];
+      world.SetAvgOrgStepsPerUpdate(config.AVG_STEPS_PER_ORG());
+      world.SetMutFun([this, i](org_t& org, emp::Random& rnd) {
+        return dirdevo::MutateOrganism(mutators[i], org, rnd);
+      });
+      world.SetSharedSystematics(&systematics, world.GetSize());
+      world.SetSharedSystematicsFlushOnUpdate(flush_on_update);
+      world.SetEpoch(0);
+      dirdevo::AvidaGPReplicator ancestor_hw(world.GetTask().GetInstLib());
+      ancestor_hw.PushInst("Scope", 0);
+      for (size_t inst = 0; inst < 94; ++inst) ancestor_hw.PushInst("Nop");
+      ancestor_hw.PushInst("GetLen", 15);
+      ancestor_hw.PushInst("Countdown", 15, 1);
+      ancestor_hw.PushInst("CopyInst", 0);
+      ancestor_hw.PushInst("Scope", 0);
+      ancestor_hw.PushInst("DivideSelf");
+      world.InjectAt(ancestor_hw.GetGenome(), 0);
+    }
+    FlushAll();
+    for (auto world_ptr : worlds) world_ptr->SyncSchedulerWeights();
+  }
+
+  ~SharedSystematicsRun() {
+    for (auto world_ptr : worlds) world_ptr.Delete();
+    for (auto rng : rngs) rng.Delete();
+  }
+
+  void FlushAll() {
+    for (auto world_ptr : worlds) world_ptr->FlushSharedSystematics();
+  }
+
+  void RunEpoch(size_t world_id, size_t epoch) {
+    world_t& world = *worlds[world_id];
+    world.SetEpoch(epoch);
+    for (size_t u = 0; u <= config.UPDATES_PER_EPOCH(); ++u) {
+      world.RunStep();
+      world.Update();
+    }
+  }
+
+  /// Every taxon the systematics manager is holding onto (active or ancestral), sorted by id.
+  emp::vector<taxon_record_t> GetTaxa() const {
+    emp::vector<taxon_record_t> taxa;
+    auto add_taxon = [&taxa](emp::Ptr<taxon_t> taxon) {
+      const size_t parent_id = (taxon->GetParent()) ? taxon->GetParent()->GetID() : (size_t)-1;
+      taxa.emplace_back(taxon->GetID(), parent_id, taxon->GetOriginationTime(), taxon->GetNumOrgs(), taxon->GetInfo().GetHash());
+    };
+    for (auto taxon : systematics.GetActive()) add_taxon(taxon);
+    for (auto taxon : systematics.GetAncestors()) add_taxon(taxon);
+    std::sort(taxa.begin(), taxa.end());
+    return taxa;
+  }
+};
+
+}
+
+TEST_CASE("Systematics events flushed at a barrier match flushing every update", "[systematics]") {
+
+  dirdevo::DirectedDevoConfig config;
+  config.SEED(2);
+  config.AVIDAGP_ENV_FILE("example-environment.json");
+  config.LOCAL_GRID_WIDTH(6);
+  config.LOCAL_GRID_HEIGHT(6);
+  config.UPDATES_PER_EPOCH(60);
+
+  // Reference: worlds run one after another, replaying their logs every update.
+  SharedSystematicsRun serial_run(config, true);
+  // Worlds run concurrently (one thread each), and logs are replayed in world order once every world reaches the barrier.
+  SharedSystematicsRun barrier_run(config, false);
+
+  for (size_t epoch = 0; epoch < NUM_EPOCHS; ++epoch) {
+    for (size_t world_id = 0; world_id < NUM_WORLDS; ++world_id) {
+      serial_run.RunEpoch(world_id, epoch);
+    }
+    serial_run.FlushAll();
+
+    emp::vector<std::thread> threads;
+    for (size_t world_id = 0; world_id < NUM_WORLDS; ++world_id) {
+      threads.emplace_back([&barrier_run, world_id, epoch]() { barrier_run.RunEpoch(world_id, epoch); });
+    }
+    for (auto& thread : threads) thread.join();
+    for (auto world_ptr : barrier_run.worlds) {
+      CHECK(world_ptr->GetSharedSystematics().events.size() > 0); // Nothing replayed before the barrier.
+    }
+    barrier_run.FlushAll();
+
+    const auto serial_taxa = serial_run.GetTaxa();
+    const auto barrier_taxa = barrier_run.GetTaxa();
+    REQUIRE(serial_taxa.size() > NUM_WORLDS);
+    REQUIRE(serial_taxa == barrier_taxa);
+    CHECK(serial_run.systematics.GetNumActive() == barrier_run.systematics.GetNumActive());
+    CHECK(serial_run.systematics.GetTotalOrgs() == barrier_run.systematics.GetTotalOrgs());
+  }
+
+}